@@ -0,0 +1,77 @@
+/**
+ * @file ColumnScanBench.cpp
+ * @brief Measures the aggregate-query throughput of EmployeeColumns on synthetic employees.
+ *
+ * Usage: employee_column_bench [rows]   (default: 10,000,000 rows)
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "EmployeeColumns.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int REPETITIONS = 5;
+
+struct NamedQuery {
+    std::string label;
+    AggregateQuery query;
+};
+
+/**
+ * @brief Fills the columns with reproducible random employees within the program's limits.
+ */
+void fillColumns(EmployeeColumns& columns, size_t rows) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> age(16, 60);
+    std::uniform_int_distribution<int> salary(2000, 100000);
+    std::bernoulli_distribution female(0.5);
+
+    columns.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        columns.insert("emp" + std::to_string(i), age(rng), salary(rng), female(rng) ? 'F' : 'M');
+    }
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    std::cout << "Generating " << rows << " synthetic employees...\n";
+    EmployeeColumns columns;
+    fillColumns(columns, rows);
+
+    std::vector<NamedQuery> queries(3);
+    queries[0].label = "all rows";
+    queries[1].label = "female, age 30-40";
+    queries[1].query.gender = 'F';
+    queries[1].query.minAge = 30;
+    queries[1].query.maxAge = 40;
+    queries[2].label = "salary >= 50000, age <= 25";
+    queries[2].query.minSalary = 50000;
+    queries[2].query.maxAge = 25;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& [label, query] : queries) {
+        double bestSeconds = 1e9;
+        AggregateResult result;
+        for (int rep = 0; rep < REPETITIONS; ++rep) {
+            auto start = Clock::now();
+            result = columns.aggregate(query);
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            bestSeconds = std::min(bestSeconds, elapsed.count());
+        }
+        std::cout << std::left << std::setw(28) << label << " matched " << std::setw(10)
+                  << result.count << " avg " << std::setw(10) << result.average() << " best "
+                  << bestSeconds * 1e3 << " ms  (" << rows / bestSeconds / 1e6
+                  << " M rows/s)\n";
+    }
+    return 0;
+}
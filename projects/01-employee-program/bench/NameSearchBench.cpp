@@ -0,0 +1,151 @@
+/**
+ * @file NameSearchBench.cpp
+ * @brief Measures name search latency on a synthetic roster.
+ *
+ * Usage: employee_name_search_bench [names]   (default: 1,000,000 names)
+ *
+ * Builds the sorted map and the NameIndex the program keeps, then times random queries taken
+ * from existing names:
+ *  - prefix list:   prefixMatches() on the map, limited to 20 names
+ *  - prefix count:  NameIndex::countPrefix()
+ *  - substring:     NameIndex::substringSearch(), limited to 20 names (2-letter queries are
+ *                   shorter than a trigram and scan every name)
+ *  - linear scan:   std::string::find over every name, the baseline the index replaces
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "NameIndex.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t QUERIES = 2000;
+constexpr size_t LINEAR_QUERIES = 20;
+constexpr size_t LIMIT = 20;
+
+/**
+ * @brief Reproducible "first last" names made of lowercase letters, like the program accepts.
+ */
+std::vector<std::string> makeNames(size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> length(3, 8);
+
+    std::vector<std::string> names;
+    names.reserve(count);
+    while (names.size() < count) {
+        std::string name;
+        for (int word = 0; word < 2; ++word) {
+            if (word) name += ' ';
+            for (int i = length(rng); i > 0; --i) name += static_cast<char>(letter(rng));
+        }
+        names.push_back(std::move(name));
+    }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    return names;
+}
+
+/**
+ * @brief Picks random substrings of existing names.
+ * @param fromStart True for prefixes, false for substrings at any position.
+ */
+std::vector<std::string> makeQueries(const std::vector<std::string>& names, size_t count,
+                                     size_t length, bool fromStart) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pick(0, names.size() - 1);
+    std::vector<std::string> queries;
+    while (queries.size() < count) {
+        const std::string& name = names[pick(rng)];
+        if (name.size() < length) continue;
+        size_t pos =
+            fromStart ? 0 : std::uniform_int_distribution<size_t>(0, name.size() - length)(rng);
+        queries.push_back(name.substr(pos, length));
+    }
+    return queries;
+}
+
+/**
+ * @brief Runs every query once and prints the mean, p50 and p99 latency in microseconds.
+ */
+template <typename Query>
+void measure(const std::string& label, const std::vector<std::string>& queries, Query query) {
+    std::vector<double> micros;
+    size_t matches = 0;
+    for (const auto& text : queries) {
+        auto start = Clock::now();
+        matches += query(text);
+        micros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    double mean = 0;
+    for (double m : micros) mean += m;
+    mean /= micros.size();
+    std::sort(micros.begin(), micros.end());
+
+    std::cout << std::left << std::setw(24) << label << std::right << std::setw(10) << mean
+              << std::setw(10) << micros[micros.size() / 2] << std::setw(10)
+              << micros[micros.size() * 99 / 100] << std::setw(14)
+              << static_cast<double>(matches) / queries.size() << "\n";
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    if (count == 0) {
+        std::cerr << "Need at least one name\n";
+        return 1;
+    }
+
+    std::vector<std::string> names = makeNames(count);
+    std::map<std::string, int> roster;
+    NameIndex index;
+
+    auto start = Clock::now();
+    index.reserve(names.size());
+    for (const auto& name : names) {
+        roster.emplace(name, 0);
+        index.insert(name);
+    }
+    std::chrono::duration<double> build = Clock::now() - start;
+    std::cout << std::fixed << std::setprecision(2) << "Indexed " << names.size() << " names in "
+              << build.count() * 1e3 << " ms\n\n";
+
+    std::cout << std::left << std::setw(24) << "query" << std::right << std::setw(10) << "mean us"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(14)
+              << "avg matches" << "\n";
+
+    for (size_t length : {1, 3, 5}) {
+        auto queries = makeQueries(names, QUERIES, length, true);
+        std::string suffix = " (" + std::to_string(length) + ")";
+        measure("prefix list" + suffix, queries, [&](const std::string& text) {
+            return prefixMatches(roster, text, LIMIT).size();
+        });
+        measure("prefix count" + suffix, queries,
+                [&](const std::string& text) { return index.countPrefix(text); });
+    }
+
+    for (size_t length : {2, 3, 4, 6}) {
+        // Queries shorter than a trigram fall back to a scan, so they get the scan's query count
+        auto queries =
+            makeQueries(names, length < NameIndex::GRAM ? LINEAR_QUERIES : QUERIES, length, false);
+        measure("substring (" + std::to_string(length) + ")", queries,
+                [&](const std::string& text) { return index.substringSearch(text, LIMIT).total; });
+    }
+
+    auto queries = makeQueries(names, LINEAR_QUERIES, 4, false);
+    measure("linear scan (4)", queries, [&](const std::string& text) {
+        size_t matches = 0;
+        for (const auto& name : names) matches += name.find(text) != std::string::npos;
+        return matches;
+    });
+    return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file SnapshotLoadBench.cpp
+ * @brief Compares startup loading of the text database with the binary snapshot.
+ *
+ * Usage: employee_snapshot_bench [rows]   (default: 1,000,000 rows)
+ *
+ * Writes employees_bench.txt and employees_bench.bin in the working directory, then times:
+ *  - text:   getline + Employee(const std::string&) per line, as loadSnapshot() does
+ *  - binary: mmap + fixed-offset row reads, building the same Employee objects
+ *  - binary open only: mmap + header validation, i.e. the cost before the first row is usable
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BinarySnapshot.hpp"
+#include "Employee.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr const char* TEXT_PATH = "employees_bench.txt";
+constexpr const char* BINARY_PATH = "employees_bench.bin";
+
+std::vector<Employee> makeEmployees(size_t rows) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> age(Employee::MIN_AGE, Employee::MAX_AGE);
+    std::uniform_int_distribution<int> salary(Employee::MIN_SALARY, Employee::MAX_SALARY);
+    std::uniform_int_distribution<int> letter('a', 'z');
+
+    std::vector<Employee> employees;
+    employees.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        std::string name(12, ' ');
+        for (size_t j = 0; j < name.size(); ++j) {
+            if (j != 5) name[j] = static_cast<char>(letter(rng));
+        }
+        employees.emplace_back(name, age(rng), salary(rng), i % 2 ? 'F' : 'M');
+    }
+    return employees;
+}
+
+/**
+ * @brief Prints the time since `start`, and the row rate unless `rows` is 0.
+ */
+void report(const std::string& label, Clock::time_point start, size_t rows) {
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    std::cout << std::left << std::setw(20) << label << std::right << std::setw(10)
+              << elapsed.count() * 1e3 << " ms";
+    if (rows > 0) std::cout << "  (" << rows / elapsed.count() / 1e6 << " M rows/s)";
+    std::cout << "\n";
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    std::cout << "Writing " << rows << " employees in both formats...\n";
+    std::vector<Employee> source = makeEmployees(rows);
+    {
+        std::ofstream text(TEXT_PATH);
+        for (const auto& emp : source) text << emp.toString() << "\n";
+    }
+    std::vector<const Employee*> pointers;
+    for (const auto& emp : source) pointers.push_back(&emp);
+    if (!BinarySnapshot::write(BINARY_PATH, pointers)) {
+        std::cerr << "Could not write " << BINARY_PATH << "\n";
+        return 1;
+    }
+    source.clear();
+    pointers.clear();
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    auto start = Clock::now();
+    std::vector<Employee> fromText;
+    {
+        std::ifstream data(TEXT_PATH);
+        std::string line;
+        while (std::getline(data, line) && !line.empty()) fromText.emplace_back(line);
+    }
+    report("text", start, fromText.size());
+
+    start = Clock::now();
+    std::vector<Employee> fromBinary;
+    {
+        BinarySnapshot::Reader reader;
+        std::string error;
+        if (!reader.open(BINARY_PATH, error)) {
+            std::cerr << "Could not load " << BINARY_PATH << ": " << error << "\n";
+            return 1;
+        }
+        fromBinary.reserve(reader.size());
+        BinarySnapshot::RowView row;
+        for (size_t i = 0; i < reader.size(); ++i) {
+            if (reader.row(i, row)) {
+                fromBinary.emplace_back(std::string(row.name), row.age, row.salary, row.gender);
+            }
+        }
+    }
+    report("binary", start, fromBinary.size());
+
+    start = Clock::now();
+    BinarySnapshot::Reader reader;
+    std::string error;
+    reader.open(BINARY_PATH, error);
+    report("binary open only", start, 0);
+
+    if (fromText.size() != fromBinary.size() ||
+        (!fromText.empty() && fromText.back().name != fromBinary.back().name)) {
+        std::cerr << "Mismatch between text and binary loads!\n";
+        return 1;
+    }
+    return 0;
+}
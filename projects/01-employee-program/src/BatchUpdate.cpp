@@ -0,0 +1,345 @@
+#include "BatchUpdate.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+using OpCode = BatchUpdate::OpCode;
+using Instruction = BatchUpdate::Instruction;
+
+struct Token {
+    enum class Kind { NUMBER, WORD, GENDER, SYMBOL, END };
+
+    Kind kind;
+    std::string text;
+    double number{0};
+    size_t pos{0};
+};
+
+/**
+ * @brief Splits a command into tokens.
+ * @throws std::invalid_argument On characters that start no token.
+ */
+std::vector<Token> tokenize(const std::string& s) {
+    std::vector<Token> tokens;
+    size_t i = 0;
+    while (i < s.size()) {
+        unsigned char c = s[i];
+        if (std::isspace(c)) {
+            ++i;
+        } else if (std::isdigit(c) || c == '.') {
+            char* end = nullptr;
+            double number = std::strtod(s.c_str() + i, &end);
+            size_t len = end - (s.c_str() + i);
+            if (len == 0) throw std::invalid_argument("bad number at position " + std::to_string(i));
+            tokens.push_back({Token::Kind::NUMBER, s.substr(i, len), number, i});
+            i += len;
+        } else if (std::isalpha(c) || c == '_') {
+            size_t start = i;
+            while (i < s.size() && (std::isalnum(static_cast<unsigned char>(s[i])) || s[i] == '_')) {
+                ++i;
+            }
+            std::string word = s.substr(start, i - start);
+            std::transform(word.begin(), word.end(), word.begin(),
+                           [](unsigned char ch) { return std::tolower(ch); });
+            tokens.push_back({Token::Kind::WORD, word, 0, start});
+        } else if (c == '\'') {
+            if (i + 2 >= s.size() || s[i + 2] != '\'') {
+                throw std::invalid_argument("bad gender literal at position " + std::to_string(i));
+            }
+            tokens.push_back({Token::Kind::GENDER, s.substr(i, 3), double(s[i + 1]), i});
+            i += 3;
+        } else {
+            static const std::string twoCharSymbols[] = {"<=", ">=", "==", "!="};
+            std::string symbol(1, s[i]);
+            for (const auto& candidate : twoCharSymbols) {
+                if (s.compare(i, 2, candidate) == 0) symbol = candidate;
+            }
+            if (symbol.size() == 1 && std::string("+-*/()<>=,").find(c) == std::string::npos) {
+                throw std::invalid_argument("unexpected '" + symbol + "' at position " +
+                                            std::to_string(i));
+            }
+            tokens.push_back({Token::Kind::SYMBOL, symbol, 0, i});
+            i += symbol.size();
+        }
+    }
+    tokens.push_back({Token::Kind::END, "end of input", 0, s.size()});
+    return tokens;
+}
+
+/**
+ * @class Parser
+ * @brief Recursive-descent parser that emits postfix code, lowest precedence first:
+ * or, and, not, comparisons, + -, * /, unary minus, primaries.
+ */
+class Parser {
+    /// Deepest chain of parentheses, function calls, 'not' and unary minus accepted
+    static constexpr int MAX_NESTING = 256;
+
+    std::vector<Token> tokens;
+    size_t current{0};
+    int nesting{0};  ///< Recursive rules currently open
+
+    /**
+     * @brief Counts one nested rule for the lifetime of a parse call.
+     */
+    class Nested {
+        int& nesting;
+
+       public:
+        explicit Nested(int& nesting) : nesting(nesting) {
+            if (++nesting > MAX_NESTING) {
+                --nesting;
+                throw std::invalid_argument("expression is nested too deeply");
+            }
+        }
+        ~Nested() { --nesting; }
+        Nested(const Nested&) = delete;
+        Nested& operator=(const Nested&) = delete;
+    };
+
+    const Token& peek() const { return tokens[current]; }
+
+    bool accept(const std::string& text) {
+        if (peek().kind != Token::Kind::END && peek().text == text) {
+            ++current;
+            return true;
+        }
+        return false;
+    }
+
+    [[noreturn]] void fail(const std::string& expected) const {
+        throw std::invalid_argument("expected " + expected + " but found '" + peek().text +
+                                    "' at position " + std::to_string(peek().pos));
+    }
+
+    void expect(const std::string& text) {
+        if (!accept(text)) fail("'" + text + "'");
+    }
+
+    void parseOr(std::vector<Instruction>& code) {
+        Nested nested(nesting);
+        parseAnd(code);
+        while (accept("or")) {
+            parseAnd(code);
+            code.push_back({OpCode::OR});
+        }
+    }
+
+    void parseAnd(std::vector<Instruction>& code) {
+        parseNot(code);
+        while (accept("and")) {
+            parseNot(code);
+            code.push_back({OpCode::AND});
+        }
+    }
+
+    void parseNot(std::vector<Instruction>& code) {
+        if (accept("not")) {
+            Nested nested(nesting);
+            parseNot(code);
+            code.push_back({OpCode::NOT});
+        } else {
+            parseComparison(code);
+        }
+    }
+
+    void parseComparison(std::vector<Instruction>& code) {
+        static const std::pair<const char*, OpCode> comparisons[] = {
+            {"<", OpCode::LT},  {"<=", OpCode::LE}, {">", OpCode::GT},
+            {">=", OpCode::GE}, {"==", OpCode::EQ}, {"!=", OpCode::NE}};
+        parseAdditive(code);
+        for (const auto& [symbol, op] : comparisons) {
+            if (accept(symbol)) {
+                parseAdditive(code);
+                code.push_back({op});
+                return;
+            }
+        }
+    }
+
+    void parseAdditive(std::vector<Instruction>& code) {
+        parseMultiplicative(code);
+        while (true) {
+            if (accept("+")) {
+                parseMultiplicative(code);
+                code.push_back({OpCode::ADD});
+            } else if (accept("-")) {
+                parseMultiplicative(code);
+                code.push_back({OpCode::SUB});
+            } else {
+                return;
+            }
+        }
+    }
+
+    void parseMultiplicative(std::vector<Instruction>& code) {
+        parseUnary(code);
+        while (true) {
+            if (accept("*")) {
+                parseUnary(code);
+                code.push_back({OpCode::MUL});
+            } else if (accept("/")) {
+                parseUnary(code);
+                code.push_back({OpCode::DIV});
+            } else {
+                return;
+            }
+        }
+    }
+
+    void parseUnary(std::vector<Instruction>& code) {
+        if (accept("-")) {
+            Nested nested(nesting);
+            parseUnary(code);
+            code.push_back({OpCode::NEG});
+        } else {
+            parsePrimary(code);
+        }
+    }
+
+    void parsePrimary(std::vector<Instruction>& code) {
+        const Token& token = peek();
+        if (token.kind == Token::Kind::NUMBER || token.kind == Token::Kind::GENDER) {
+            code.push_back({OpCode::CONST, token.number});
+            ++current;
+        } else if (accept("age")) {
+            code.push_back({OpCode::AGE});
+        } else if (accept("salary")) {
+            code.push_back({OpCode::SALARY});
+        } else if (accept("gender")) {
+            code.push_back({OpCode::GENDER});
+        } else if (token.text == "min" || token.text == "max") {
+            OpCode op = token.text == "min" ? OpCode::MIN : OpCode::MAX;
+            ++current;
+            expect("(");
+            parseOr(code);
+            expect(",");
+            parseOr(code);
+            expect(")");
+            code.push_back({op});
+        } else if (accept("(")) {
+            parseOr(code);
+            expect(")");
+        } else {
+            fail("a number, field, function or '('");
+        }
+    }
+
+    /**
+     * @brief Checks that a program fits the fixed evaluation stack.
+     */
+    static void checkDepth(const std::vector<Instruction>& code) {
+        int depth = 0;
+        for (const auto& instruction : code) {
+            bool pushes = instruction.op <= OpCode::GENDER;
+            bool unary = instruction.op == OpCode::NEG || instruction.op == OpCode::NOT;
+            depth += pushes ? 1 : (unary ? 0 : -1);
+            if (depth > BatchUpdate::MAX_STACK_DEPTH) {
+                throw std::invalid_argument("expression is nested too deeply");
+            }
+        }
+    }
+
+   public:
+    explicit Parser(const std::string& command) : tokens(tokenize(command)) {}
+
+    /**
+     * @brief Parses "salary = <expr> [where <expr>]".
+     */
+    void parseCommand(std::vector<Instruction>& valueCode, std::vector<Instruction>& condition) {
+        expect("salary");
+        expect("=");
+        parseOr(valueCode);
+        if (accept("where")) parseOr(condition);
+        if (peek().kind != Token::Kind::END) fail("'where' or end of command");
+        checkDepth(valueCode);
+        checkDepth(condition);
+    }
+};
+}  // namespace
+
+BatchUpdate::BatchUpdate(std::string command) : text(std::move(command)) {
+    Parser(text).parseCommand(valueCode, conditionCode);
+}
+
+double BatchUpdate::run(const std::vector<Instruction>& code, const EmployeeFields& fields) {
+    double stack[MAX_STACK_DEPTH];
+    int top = -1;
+    for (const auto& [op, value] : code) {
+        switch (op) {
+            case OpCode::CONST:
+                stack[++top] = value;
+                continue;
+            case OpCode::AGE:
+                stack[++top] = fields.age;
+                continue;
+            case OpCode::SALARY:
+                stack[++top] = fields.salary;
+                continue;
+            case OpCode::GENDER:
+                stack[++top] = fields.gender;
+                continue;
+            case OpCode::NEG:
+                stack[top] = -stack[top];
+                continue;
+            case OpCode::NOT:
+                stack[top] = stack[top] == 0;
+                continue;
+            default:
+                break;
+        }
+
+        double rhs = stack[top--];
+        double& lhs = stack[top];
+        switch (op) {
+            case OpCode::ADD:
+                lhs += rhs;
+                break;
+            case OpCode::SUB:
+                lhs -= rhs;
+                break;
+            case OpCode::MUL:
+                lhs *= rhs;
+                break;
+            case OpCode::DIV:
+                lhs /= rhs;
+                break;
+            case OpCode::LT:
+                lhs = lhs < rhs;
+                break;
+            case OpCode::LE:
+                lhs = lhs <= rhs;
+                break;
+            case OpCode::GT:
+                lhs = lhs > rhs;
+                break;
+            case OpCode::GE:
+                lhs = lhs >= rhs;
+                break;
+            case OpCode::EQ:
+                lhs = lhs == rhs;
+                break;
+            case OpCode::NE:
+                lhs = lhs != rhs;
+                break;
+            case OpCode::AND:
+                lhs = lhs != 0 && rhs != 0;
+                break;
+            case OpCode::OR:
+                lhs = lhs != 0 || rhs != 0;
+                break;
+            case OpCode::MIN:
+                lhs = std::min(lhs, rhs);
+                break;
+            case OpCode::MAX:
+                lhs = std::max(lhs, rhs);
+                break;
+            default:
+                break;
+        }
+    }
+    return stack[top];
+}
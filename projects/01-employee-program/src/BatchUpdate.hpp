@@ -0,0 +1,99 @@
+/**
+ * @file BatchUpdate.hpp
+ * @brief A tiny expression language for updating many employee salaries in one command.
+ *
+ * Syntax:
+ *
+ *     salary = <expression> [where <expression>]
+ *
+ * Expressions are built from numbers, the fields `age`, `salary` and `gender`, gender literals
+ * ('M' or 'F'), the arithmetic operators + - * /, the comparisons < <= > >= == !=, the logical
+ * operators `and`, `or` and `not`, the functions min(a, b) and max(a, b), and parentheses.
+ * Comparisons and logical operators yield 1 or 0, and any non-zero value counts as true.
+ *
+ * Example: `salary = salary * 1.07 where age >= 25 and age <= 35`
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct EmployeeFields
+ * @brief The employee fields an expression can read.
+ */
+struct EmployeeFields {
+    int age;
+    int salary;
+    char gender;
+};
+
+/**
+ * @class BatchUpdate
+ * @brief A parsed batch-update command, compiled to postfix code for fast per-row evaluation.
+ */
+class BatchUpdate {
+   public:
+    enum class OpCode {
+        CONST,
+        AGE,
+        SALARY,
+        GENDER,
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        NEG,
+        LT,
+        LE,
+        GT,
+        GE,
+        EQ,
+        NE,
+        AND,
+        OR,
+        NOT,
+        MIN,
+        MAX
+    };
+
+    struct Instruction {
+        OpCode op;
+        double value{0};  ///< Operand of CONST
+    };
+
+    static constexpr int MAX_STACK_DEPTH = 64;
+
+   private:
+    std::string text;
+    std::vector<Instruction> valueCode;
+    std::vector<Instruction> conditionCode;  ///< Empty when there is no `where` clause
+
+    static double run(const std::vector<Instruction>& code, const EmployeeFields& fields);
+
+   public:
+    /**
+     * @brief Parses a batch-update command.
+     * @param command The command text.
+     * @throws std::invalid_argument If the command is malformed; the message says why.
+     */
+    explicit BatchUpdate(std::string command);
+
+    /**
+     * @brief Checks if an employee satisfies the `where` clause (always true without one).
+     */
+    bool matches(const EmployeeFields& fields) const {
+        return conditionCode.empty() || run(conditionCode, fields) != 0;
+    }
+
+    /**
+     * @brief Evaluates the new salary of an employee (unclamped and unrounded).
+     */
+    double evaluate(const EmployeeFields& fields) const { return run(valueCode, fields); }
+
+    /**
+     * @brief The command text the update was parsed from.
+     */
+    const std::string& getText() const { return text; }
+};
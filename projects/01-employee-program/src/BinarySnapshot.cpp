@@ -0,0 +1,142 @@
+#include "BinarySnapshot.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace BinarySnapshot {
+bool Reader::open(const std::string& path, std::string& error) {
+    if (!file.open(path)) {
+        error = "cannot open " + path;
+        return false;
+    }
+    Header header;
+    if (file.size() < sizeof(header)) {
+        error = "file too small for a snapshot header";
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "not an employee snapshot";
+        return false;
+    }
+    if (header.version != VERSION || header.rowSize != sizeof(Row)) {
+        error = "unsupported snapshot version";
+        return false;
+    }
+    uint64_t available = file.size() - sizeof(header);
+    if (header.rowCount > available / sizeof(Row) ||
+        header.stringTableSize > available - header.rowCount * sizeof(Row)) {
+        error = "snapshot is truncated";
+        return false;
+    }
+
+    rows = file.data() + sizeof(header);
+    strings = rows + header.rowCount * sizeof(Row);
+    rowCount = header.rowCount;
+    stringTableSize = header.stringTableSize;
+    return true;
+}
+
+bool Reader::row(size_t index, RowView& out) const {
+    Row row;
+    std::memcpy(&row, rows + index * sizeof(Row), sizeof(Row));
+    if (uint64_t(row.nameOffset) + row.nameLength > stringTableSize) return false;
+    out.name = std::string_view(strings + row.nameOffset, row.nameLength);
+    out.age = row.age;
+    out.salary = row.salary;
+    out.gender = row.gender;
+    return true;
+}
+
+bool write(const std::string& path, const std::vector<const Employee*>& employees) {
+    std::vector<Row> rows;
+    rows.reserve(employees.size());
+    uint64_t tableSize = 0;
+    for (const Employee* emp : employees) {
+        Row row{};
+        row.nameOffset = static_cast<uint32_t>(tableSize);
+        row.nameLength = static_cast<uint32_t>(emp->name.size());
+        row.age = emp->age;
+        row.salary = emp->salary;
+        row.gender = emp->gender;
+        rows.push_back(row);
+        tableSize += emp->name.size();
+        if (tableSize > std::numeric_limits<uint32_t>::max()) return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.rowSize = sizeof(Row);
+    header.rowCount = rows.size();
+    header.stringTableSize = tableSize;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (out.fail()) return false;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(rows.data()), rows.size() * sizeof(Row));
+    for (const Employee* emp : employees) {
+        out.write(emp->name.data(), emp->name.size());
+    }
+    out.close();
+    return !out.fail();
+}
+
+bool convertTextToBinary(const std::string& textPath, const std::string& binaryPath,
+                         std::vector<std::string>& skipped, std::string& error) {
+    std::ifstream in(textPath);
+    if (in.fail()) {
+        error = "cannot open " + textPath;
+        return false;
+    }
+    std::vector<Employee> employees;
+    std::string line;
+    while (std::getline(in, line) && !line.empty()) {
+        Employee emp(line);
+        if (!emp.isValid()) {
+            skipped.push_back(line);
+            continue;
+        }
+        employees.push_back(std::move(emp));
+    }
+
+    std::vector<const Employee*> rows;
+    rows.reserve(employees.size());
+    for (const auto& emp : employees) rows.push_back(&emp);
+    if (!write(binaryPath, rows)) {
+        error = "cannot write " + binaryPath;
+        return false;
+    }
+    return true;
+}
+
+bool convertBinaryToText(const std::string& binaryPath, const std::string& textPath,
+                         std::string& error) {
+    Reader reader;
+    if (!reader.open(binaryPath, error)) return false;
+
+    std::ofstream out(textPath, std::ios::trunc);
+    if (out.fail()) {
+        error = "cannot write " + textPath;
+        return false;
+    }
+    RowView row;
+    for (size_t i = 0; i < reader.size(); ++i) {
+        if (!reader.row(i, row) ||
+            !Employee(std::string(row.name), row.age, row.salary, row.gender).isValid()) {
+            error = "row " + std::to_string(i) + " is corrupted";
+            return false;
+        }
+        out << row.name << Employee::DELIM << row.age << Employee::DELIM << row.salary
+            << Employee::DELIM << row.gender << "\n";
+    }
+    out.close();
+    if (out.fail()) {
+        error = "cannot write " + textPath;
+        return false;
+    }
+    return true;
+}
+}  // namespace BinarySnapshot
@@ -0,0 +1,114 @@
+/**
+ * @file BinarySnapshot.hpp
+ * @brief Fixed-layout binary snapshot of the employee roster, loadable with mmap.
+ *
+ * File layout (native byte order):
+ *
+ *     Header                      32 bytes
+ *     Row[rowCount]               20 bytes each: name offset/length, age, salary, gender
+ *     char[stringTableSize]       all names back to back, not NUL-terminated
+ *
+ * Reading a row is a fixed-offset copy; nothing is parsed.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Employee.hpp"
+#include "MappedFile.hpp"
+
+namespace BinarySnapshot {
+constexpr char MAGIC[8] = {'E', 'M', 'P', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t VERSION = 1;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t rowSize;  ///< sizeof(Row), guards against layout changes
+    uint64_t rowCount;
+    uint64_t stringTableSize;
+};
+
+struct Row {
+    uint32_t nameOffset;  ///< Into the string table
+    uint32_t nameLength;
+    int32_t age;
+    int32_t salary;
+    char gender;
+    char padding[3];
+};
+
+static_assert(sizeof(Header) == 32, "unexpected snapshot header layout");
+static_assert(sizeof(Row) == 20, "unexpected snapshot row layout");
+
+/**
+ * @struct RowView
+ * @brief One decoded row; `name` points into the mapped file.
+ */
+struct RowView {
+    std::string_view name;
+    int age;
+    int salary;
+    char gender;
+};
+
+/**
+ * @class Reader
+ * @brief Maps a snapshot file and gives random access to its rows.
+ */
+class Reader {
+    MappedFile file;
+    const char* rows{nullptr};
+    const char* strings{nullptr};
+    uint64_t rowCount{0};
+    uint64_t stringTableSize{0};
+
+   public:
+    /**
+     * @brief Maps a snapshot and validates its header and section sizes (O(1)).
+     * @param path The snapshot file.
+     * @param error Receives the reason on failure.
+     * @return True if the file is a readable snapshot.
+     */
+    bool open(const std::string& path, std::string& error);
+
+    size_t size() const { return rowCount; }
+
+    /**
+     * @brief Reads one row.
+     * @param index Row index, less than size().
+     * @param out Receives the row.
+     * @return False if the row's name lies outside the string table.
+     */
+    bool row(size_t index, RowView& out) const;
+};
+
+/**
+ * @brief Writes a snapshot of the given employees.
+ * @param path The file to (over)write.
+ * @param employees The rows to store, in order.
+ * @return True on success.
+ */
+bool write(const std::string& path, const std::vector<const Employee*>& employees);
+
+/**
+ * @brief Converts a text database (one "name|age|salary|gender" per line) to a snapshot.
+ *
+ * Rows that fail Employee::isValid() are left out, as loading the text database does.
+ * @param skipped Receives the lines that were left out, in file order.
+ * @param error Receives the reason on failure.
+ */
+bool convertTextToBinary(const std::string& textPath, const std::string& binaryPath,
+                         std::vector<std::string>& skipped, std::string& error);
+
+/**
+ * @brief Converts a snapshot back to a text database.
+ * @param error Receives the reason on failure.
+ */
+bool convertBinaryToText(const std::string& binaryPath, const std::string& textPath,
+                         std::string& error);
+}  // namespace BinarySnapshot
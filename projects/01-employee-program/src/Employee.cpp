@@ -0,0 +1,56 @@
+#include "Employee.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+#include "Helper.hpp"
+
+Employee::Employee(const std::string& empStr) {
+    std::istringstream iss(empStr);
+    std::getline(iss, name, DELIM);
+    iss >> age;
+    iss.ignore();
+    iss >> salary;
+    iss.ignore();
+    iss >> gender;
+}
+
+bool Employee::parseRow(std::string_view line, char delim, Employee& emp) {
+    std::string_view fields[4];
+    for (int i = 0; i < 4; ++i) {
+        size_t end = i < 3 ? line.find(delim) : line.size();
+        if (end == std::string_view::npos) return false;
+        fields[i] = Helper::trimmed(line.substr(0, end));
+        line.remove_prefix(i < 3 ? end + 1 : end);
+    }
+    if (fields[3].size() != 1) return false;
+
+    emp.name = fields[0];
+    emp.gender = fields[3][0];
+    return Helper::parseInt(fields[1], emp.age) && Helper::parseInt(fields[2], emp.salary) &&
+           isValidName(emp.name) && isValidAge(emp.age) && isValidSalary(emp.salary) &&
+           isValidGender(emp.gender);
+}
+
+bool Employee::isValidName(const std::string& name) {
+    if (name.empty() || name[0] == ' ' || name.size() <= 2) {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::islower(static_cast<unsigned char>(c)) || c == ' ';
+    });
+}
+
+void Employee::print() const {
+    std::cout << "Name: " << name << "\n"
+              << "Age: " << age << "\n"
+              << "Salary: " << salary << "\n"
+              << "Gender: " << gender << "\n";
+}
+
+std::string Employee::toString() const {
+    std::ostringstream oss;
+    oss << name << DELIM << age << DELIM << salary << DELIM << gender;
+    return oss.str();
+}
@@ -0,0 +1,106 @@
+/**
+ * @file Employee.hpp
+ * @brief The employee record, its validation rules and its text format.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @struct Employee
+ * @brief Represents a single employee record.
+ */
+struct Employee {
+    static constexpr int MIN_SALARY = 2000;
+    static constexpr int MAX_SALARY = 100000;
+    static constexpr int MIN_AGE = 16;
+    static constexpr int MAX_AGE = 60;
+    static constexpr char DELIM = '|';
+
+    std::string name;
+    int age{-1};
+    int salary{-1};
+    char gender{'N'};
+
+    Employee() = default;
+
+    /**
+     * @brief Constructs an Employee with given details.
+     * @param name The name of the employee.
+     * @param age The age of the employee.
+     * @param salary The salary of the employee.
+     * @param gender The gender of the employee ('M' or 'F').
+     */
+    Employee(std::string name, int age, int salary, char gender)
+        : name(std::move(name)), age(age), salary(salary), gender(gender) {}
+
+    /**
+     * @brief Constructs an Employee from a delimited string.
+     * @param empStr The string containing employee data separated by delimiters.
+     */
+    explicit Employee(const std::string& empStr);
+
+    /**
+     * @brief Parses and validates one "name<delim>age<delim>salary<delim>gender" row.
+     *
+     * Fields may be surrounded by whitespace. Unlike the string constructor, this applies
+     * every isValid* rule, and it does not allocate except for the name.
+     * @param line The row, without its line terminator.
+     * @param delim The field delimiter.
+     * @param emp Receives the employee if the row is valid.
+     * @return True if the row was well formed and valid, false otherwise.
+     */
+    static bool parseRow(std::string_view line, char delim, Employee& emp);
+
+    /**
+     * @brief Checks if a salary is within the valid range.
+     * @param salary The salary to check.
+     * @return True if valid, false otherwise.
+     */
+    static bool isValidSalary(int salary) { return salary >= MIN_SALARY && salary <= MAX_SALARY; }
+
+    /**
+     * @brief Checks if a name is valid.
+     * @param name The name to check.
+     * @return True if valid (not empty, starts with non-space, >2 chars, all lower or space),
+     * false otherwise.
+     */
+    static bool isValidName(const std::string& name);
+
+    /**
+     * @brief Checks if an age is within the valid range.
+     * @param age The age to check.
+     * @return True if valid, false otherwise.
+     */
+    static bool isValidAge(int age) { return age >= MIN_AGE && age <= MAX_AGE; }
+
+    /**
+     * @brief Checks if a gender is valid.
+     * @param gender The gender to check ('M' or 'F').
+     * @return True if valid, false otherwise.
+     */
+    static bool isValidGender(char gender) { return gender == 'M' || gender == 'F'; }
+
+    /**
+     * @brief Checks every field against its isValid* rule.
+     * @return True if the employee could have been entered through the menu.
+     */
+    bool isValid() const {
+        return isValidName(name) && isValidAge(age) && isValidSalary(salary) &&
+               isValidGender(gender);
+    }
+
+    /**
+     * @brief Prints employee details to stdout.
+     */
+    void print() const;
+
+    /**
+     * @brief Converts employee data to a delimited string.
+     * @return A string representation of the employee for storage.
+     */
+    std::string toString() const;
+};
@@ -0,0 +1,89 @@
+#include "EmployeeColumns.hpp"
+
+#include <algorithm>
+#include <climits>
+
+void EmployeeColumns::insert(const std::string& name, int age, int salary, char gender) {
+    rowOf[name] = names.size();
+    names.push_back(name);
+    ages.push_back(age);
+    salaries.push_back(salary);
+    genders.push_back(gender);
+}
+
+bool EmployeeColumns::erase(const std::string& name) {
+    auto it = rowOf.find(name);
+    if (it == rowOf.end()) return false;
+
+    size_t row = it->second;
+    size_t last = names.size() - 1;
+    if (row != last) {
+        ages[row] = ages[last];
+        salaries[row] = salaries[last];
+        genders[row] = genders[last];
+        names[row] = std::move(names[last]);
+        rowOf[names[row]] = row;
+    }
+    rowOf.erase(it);
+    names.pop_back();
+    ages.pop_back();
+    salaries.pop_back();
+    genders.pop_back();
+    return true;
+}
+
+bool EmployeeColumns::setSalary(const std::string& name, int salary) {
+    auto it = rowOf.find(name);
+    if (it == rowOf.end()) return false;
+    salaries[it->second] = salary;
+    return true;
+}
+
+void EmployeeColumns::clear() {
+    ages.clear();
+    salaries.clear();
+    genders.clear();
+    names.clear();
+    rowOf.clear();
+}
+
+void EmployeeColumns::reserve(size_t rows) {
+    ages.reserve(rows);
+    salaries.reserve(rows);
+    genders.reserve(rows);
+    names.reserve(rows);
+    rowOf.reserve(rows);
+}
+
+AggregateResult EmployeeColumns::aggregate(const AggregateQuery& query) const {
+    const int* age = ages.data();
+    const int* salary = salaries.data();
+    const char* gender = genders.data();
+    const size_t rows = size();
+    const int anyGender = query.gender == AggregateQuery::ANY_GENDER;
+
+    // Every predicate is evaluated for every row and turned into an all-ones/all-zeros mask
+    // instead of a branch or a ternary. That keeps the loop body straight-line code the
+    // compiler turns into packed compares, ANDs and min/max (GCC would not if-convert the
+    // ternary form).
+    AggregateResult result;
+    long long count = 0;
+    long long sum = 0;
+    int minSalary = INT_MAX;
+    int maxSalary = INT_MIN;
+    for (size_t i = 0; i < rows; ++i) {
+        int s = salary[i];
+        int mask = -((age[i] >= query.minAge) & (age[i] <= query.maxAge) &
+                     (s >= query.minSalary) & (s <= query.maxSalary) &
+                     (anyGender | (gender[i] == query.gender)));
+        count += mask & 1;
+        sum += s & mask;
+        minSalary = std::min(minSalary, (s & mask) | (INT_MAX & ~mask));
+        maxSalary = std::max(maxSalary, (s & mask) | (INT_MIN & ~mask));
+    }
+    result.count = count;
+    result.sum = sum;
+    result.min = minSalary;
+    result.max = maxSalary;
+    return result;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file EmployeeColumns.hpp
+ * @brief Struct-of-arrays view of the employee roster used for aggregate queries.
+ */
+
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct AggregateQuery
+ * @brief Predicate of an aggregate query. All bounds are inclusive.
+ */
+struct AggregateQuery {
+    static constexpr char ANY_GENDER = '*';
+
+    int minAge{INT_MIN};
+    int maxAge{INT_MAX};
+    int minSalary{INT_MIN};
+    int maxSalary{INT_MAX};
+    char gender{ANY_GENDER};  ///< 'M', 'F' or ANY_GENDER
+};
+
+/**
+ * @struct AggregateResult
+ * @brief Count, sum, min and max of the salaries matched by an AggregateQuery.
+ */
+struct AggregateResult {
+    long long count{0};
+    long long sum{0};
+    int min{INT_MAX};  ///< INT_MAX when nothing matched
+    int max{INT_MIN};  ///< INT_MIN when nothing matched
+
+    /**
+     * @brief Average salary of the matched rows.
+     * @return The average, or 0 if nothing matched.
+     */
+    double average() const { return count ? static_cast<double>(sum) / count : 0.0; }
+};
+
+/**
+ * @class EmployeeColumns
+ * @brief Keeps age, salary and gender in contiguous columns, one row per employee.
+ *
+ * Rows are unordered: erasing moves the last row into the freed slot, so every operation
+ * except aggregate() is O(1) on average.
+ */
+class EmployeeColumns {
+    std::vector<int> ages;
+    std::vector<int> salaries;
+    std::vector<char> genders;
+    std::vector<std::string> names;                ///< Row -> employee name
+    std::unordered_map<std::string, size_t> rowOf;  ///< Employee name -> row
+
+   public:
+    /**
+     * @brief Appends a row. The name must not be present already.
+     */
+    void insert(const std::string& name, int age, int salary, char gender);
+
+    /**
+     * @brief Removes the row of an employee.
+     * @return True if the employee had a row, false otherwise.
+     */
+    bool erase(const std::string& name);
+
+    /**
+     * @brief Updates the salary column of an employee.
+     * @return True if the employee had a row, false otherwise.
+     */
+    bool setSalary(const std::string& name, int salary);
+
+    /**
+     * @brief Removes every row.
+     */
+    void clear();
+
+    /**
+     * @brief Reserves capacity for a number of rows.
+     */
+    void reserve(size_t rows);
+
+    size_t size() const { return ages.size(); }
+
+    const std::string& nameAt(size_t row) const { return names[row]; }
+    int ageAt(size_t row) const { return ages[row]; }
+    int salaryAt(size_t row) const { return salaries[row]; }
+    char genderAt(size_t row) const { return genders[row]; }
+
+    /**
+     * @brief Aggregates the salaries of all rows matching a query.
+     *
+     * The scan is branch-free over the columns so the compiler can vectorize it.
+     */
+    AggregateResult aggregate(const AggregateQuery& query) const;
+};
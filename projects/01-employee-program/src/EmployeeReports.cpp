@@ -0,0 +1,78 @@
+#include "EmployeeReports.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+
+namespace {
+/**
+ * @brief Selects the K best rows with a bounded heap whose top is the worst row kept.
+ * @param better Strict ordering: better(a, b) is true if row a ranks before row b.
+ * @return The selected rows, best first.
+ */
+template <typename Better>
+std::vector<size_t> selectTopK(size_t rows, size_t k, Better better) {
+    std::priority_queue<size_t, std::vector<size_t>, Better> heap(better);
+    if (k == 0) return {};
+    for (size_t row = 0; row < rows; ++row) {
+        if (heap.size() < k) {
+            heap.push(row);
+        } else if (better(row, heap.top())) {
+            heap.pop();
+            heap.push(row);
+        }
+    }
+
+    std::vector<size_t> result(heap.size());
+    for (size_t i = result.size(); i-- > 0; heap.pop()) result[i] = heap.top();
+    return result;
+}
+}  // namespace
+
+std::vector<size_t> EmployeeReports::topEarners(size_t k) const {
+    const EmployeeColumns& cols = columns;
+    return selectTopK(cols.size(), k, [&cols](size_t a, size_t b) {
+        if (cols.salaryAt(a) != cols.salaryAt(b)) return cols.salaryAt(a) > cols.salaryAt(b);
+        return cols.nameAt(a) < cols.nameAt(b);
+    });
+}
+
+std::vector<size_t> EmployeeReports::youngest(size_t k) const {
+    const EmployeeColumns& cols = columns;
+    return selectTopK(cols.size(), k, [&cols](size_t a, size_t b) {
+        if (cols.ageAt(a) != cols.ageAt(b)) return cols.ageAt(a) < cols.ageAt(b);
+        return cols.nameAt(a) < cols.nameAt(b);
+    });
+}
+
+std::vector<int> EmployeeReports::salaryPercentiles(char gender,
+                                                    const std::vector<double>& percents,
+                                                    size_t& count) const {
+    std::vector<int> salaries;
+    for (size_t row = 0; row < columns.size(); ++row) {
+        if (gender == AggregateQuery::ANY_GENDER || columns.genderAt(row) == gender) {
+            salaries.push_back(columns.salaryAt(row));
+        }
+    }
+    count = salaries.size();
+    if (salaries.empty()) return {};
+
+    // Visit the requested ranks in increasing order so every nth_element only has to
+    // partition the part of the array to the right of the previous rank.
+    std::vector<size_t> order(percents.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&percents](size_t a, size_t b) { return percents[a] < percents[b]; });
+
+    std::vector<int> result(percents.size());
+    size_t lowest = 0;
+    for (size_t i : order) {
+        double rank = std::ceil(percents[i] / 100.0 * salaries.size());
+        size_t index = static_cast<size_t>(std::clamp(rank, 1.0, double(salaries.size()))) - 1;
+        std::nth_element(salaries.begin() + lowest, salaries.begin() + index, salaries.end());
+        result[i] = salaries[index];
+        lowest = index;
+    }
+    return result;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file EmployeeReports.hpp
+ * @brief Top-K and percentile reports computed over the columnar employee view.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "EmployeeColumns.hpp"
+
+/**
+ * @class EmployeeReports
+ * @brief Answers ranking questions without sorting or copying the roster.
+ *
+ * Top-K reports keep a bounded heap of K rows while scanning one column (O(n log K) time,
+ * O(K) memory). Percentiles gather only the salaries of the selected gender and locate each
+ * requested rank with std::nth_element (O(n) per percentile).
+ */
+class EmployeeReports {
+    const EmployeeColumns& columns;
+
+   public:
+    explicit EmployeeReports(const EmployeeColumns& columns) : columns(columns) {}
+
+    /**
+     * @brief The K best-paid employees, highest salary first (ties by name).
+     * @return Row indices into the columns.
+     */
+    std::vector<size_t> topEarners(size_t k) const;
+
+    /**
+     * @brief The K youngest employees, youngest first (ties by name).
+     * @return Row indices into the columns.
+     */
+    std::vector<size_t> youngest(size_t k) const;
+
+    /**
+     * @brief Nearest-rank salary percentiles of one gender.
+     * @param gender 'M', 'F' or AggregateQuery::ANY_GENDER.
+     * @param percents Requested percentiles in (0, 100].
+     * @param count Receives the number of employees of that gender.
+     * @return One salary per requested percentile (empty if there are no such employees).
+     */
+    std::vector<int> salaryPercentiles(char gender, const std::vector<double>& percents,
+                                       size_t& count) const;
+};
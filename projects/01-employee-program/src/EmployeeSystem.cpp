@@ -3,7 +3,9 @@
  * @brief A simple employee management system with file persistence.
  *
  * This program allows users to add, view, update, and delete employee records.
- * Data is persisted to a text file (employees.txt).
+ * Data is persisted to a snapshot file plus an append-only journal (employees.journal) that
+ * is periodically compacted into a fresh snapshot. The snapshot is the text file
+ * employees.txt, or the memory-mapped binary file employees.bin when that one exists.
  *
  * @author Abdurrahman-sefn
  * @date 2025-12-24
@@ -11,167 +13,156 @@
 
 #include <Sefn/InputUtils.hpp>
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <map>
-#include <sstream>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
-/**
- * @namespace Helper
- * @brief Utility functions for string manipulation and conversion.
- */
-namespace Helper {
-const std::string WHITESPACE = " \n\r\t\f\v";
-
-/**
- * @brief Trims leading whitespace from a string.
- * @param s The string to trim.
- */
-void lTrim(std::string& s) {
-    size_t start = s.find_first_not_of(WHITESPACE);
-    if (start == std::string::npos) {
-        s.clear();
-    } else {
-        s.erase(0, start);
-    }
-}
-
-/**
- * @brief Trims trailing whitespace from a string.
- * @param s The string to trim.
- */
-void rTrim(std::string& s) {
-    size_t end = s.find_last_not_of(WHITESPACE);
-    if (end == std::string::npos) {
-        s.clear();
-    } else {
-        s.erase(end + 1);
-    }
-}
-
-/**
- * @brief Trims both leading and trailing whitespace from a string.
- * @param s The string to trim.
- */
-void trim(std::string& s) {
-    rTrim(s);
-    lTrim(s);
-}
-}  // namespace Helper
+#include "BatchUpdate.hpp"
+#include "BinarySnapshot.hpp"
+#include "Employee.hpp"
+#include "EmployeeColumns.hpp"
+#include "EmployeeReports.hpp"
+#include "Helper.hpp"
+#include "NameIndex.hpp"
 
 /**
  * @class EmployeeSystem
  * @brief Manages a collection of employees with persistent storage.
  */
 class EmployeeSystem {
-    static constexpr int MIN_SALARY = 2000;
-    static constexpr int MAX_SALARY = 100000;
-    static constexpr int MIN_AGE = 16;
-    static constexpr int MAX_AGE = 60;
+    static constexpr int MIN_SALARY = Employee::MIN_SALARY;
+    static constexpr int MAX_SALARY = Employee::MAX_SALARY;
+    static constexpr int MIN_AGE = Employee::MIN_AGE;
+    static constexpr int MAX_AGE = Employee::MAX_AGE;
     static constexpr const char* DATABASE_PATH = "employees.txt";
+    static constexpr const char* BINARY_DATABASE_PATH = "employees.bin";
+    static constexpr const char* JOURNAL_PATH = "employees.journal";
+    static constexpr size_t MIN_COMPACTION_RECORDS = 1024;
+    static constexpr size_t MIN_IMPORT_CHUNK_BYTES = 1 << 20;
+    static constexpr size_t MAX_REPORTED_IMPORT_ISSUES = 10;
+    static constexpr size_t PAGE_SIZE = 20;
+    static constexpr size_t SEARCH_LIMIT = 20;
+    static constexpr size_t MAX_SUGGESTIONS = 5;
+
+    // Journal record tags: "A|<employee>", "D|<name>", "S|<name>|<salary>", and "G|<count>"
+    // followed by that many records that only count together. "B|<batch command>" records of
+    // earlier versions are still replayed.
+    static constexpr char JOURNAL_ADD = 'A';
+    static constexpr char JOURNAL_DELETE = 'D';
+    static constexpr char JOURNAL_SALARY = 'S';
+    static constexpr char JOURNAL_GROUP = 'G';
+    static constexpr char JOURNAL_BATCH = 'B';
 
     /**
-     * @struct Employee
-     * @brief Represents a single employee record.
+     * @struct ImportChunk
+     * @brief The rows one bulk-import worker parsed out of its slice of the file.
      */
-    struct Employee {
-        static constexpr char DELIM = '|';
+    struct ImportChunk {
+        std::vector<Employee> rows;
+        std::vector<size_t> invalidLines;  ///< 1-based, relative to the chunk's first line
+        size_t lines{0};
+    };
 
-        std::string name;
-        int age{-1};
-        int salary{-1};
-        char gender{'N'};
-
-        Employee() = default;
-
-        /**
-         * @brief Constructs an Employee with given details.
-         * @param name The name of the employee.
-         * @param age The age of the employee.
-         * @param salary The salary of the employee.
-         * @param gender The gender of the employee ('M' or 'F').
-         */
-        Employee(std::string name, int age, int salary, char gender)
-            : name(std::move(name)), age(age), salary(salary), gender(gender) {}
-
-        /**
-         * @brief Constructs an Employee from a delimited string.
-         * @param empStr The string containing employee data separated by delimiters.
-         */
-        explicit Employee(const std::string& empStr) {
-            std::istringstream iss(empStr);
-            std::getline(iss, name, DELIM);
-            iss >> age;
-            iss.ignore();
-            iss >> salary;
-            iss.ignore();
-            iss >> gender;
-        }
-
-        /**
-         * @brief Checks if a salary is within the valid range.
-         * @param salary The salary to check.
-         * @return True if valid, false otherwise.
-         */
-        static bool isValidSalary(int salary) {
-            return salary >= MIN_SALARY && salary <= MAX_SALARY;
-        }
-
-        /**
-         * @brief Checks if a name is valid.
-         * @param name The name to check.
-         * @return True if valid (not empty, starts with non-space, >2 chars, all lower or space),
-         * false otherwise.
-         */
-        static bool isValidName(const std::string& name) {
-            if (name.empty() || name[0] == ' ' || name.size() <= 2) {
-                return false;
-            }
-            return std::all_of(name.begin(), name.end(), [](char c) {
-                return std::islower(static_cast<unsigned char>(c)) || c == ' ';
-            });
-        }
-
-        /**
-         * @brief Checks if an age is within the valid range.
-         * @param age The age to check.
-         * @return True if valid, false otherwise.
-         */
-        static bool isValidAge(int age) { return age >= MIN_AGE && age <= MAX_AGE; }
-
-        /**
-         * @brief Checks if a gender is valid.
-         * @param gender The gender to check ('M' or 'F').
-         * @return True if valid, false otherwise.
-         */
-        static bool isValidGender(char gender) { return gender == 'M' || gender == 'F'; }
-
-        /**
-         * @brief Prints employee details to stdout.
-         */
-        void print() const {
-            std::cout << "Name: " << name << "\n"
-                      << "Age: " << age << "\n"
-                      << "Salary: " << salary << "\n"
-                      << "Gender: " << gender << "\n";
-        }
-
-        /**
-         * @brief Converts employee data to a delimited string.
-         * @return A string representation of the employee for storage.
-         */
-        std::string toString() const {
-            std::ostringstream oss;
-            oss << name << DELIM << age << DELIM << salary << DELIM << gender;
-            return oss.str();
-        }
+    /**
+     * @struct BatchUpdateStats
+     * @brief Outcome of applying a BatchUpdate.
+     */
+    struct BatchUpdateStats {
+        size_t matched{0};  ///< Rows satisfying the where clause
+        size_t changed{0};  ///< Rows whose salary actually changed
+        size_t clamped{0};  ///< Rows whose new salary was clamped to [MIN_SALARY, MAX_SALARY]
+        std::vector<std::string> changedNames;  ///< In roster order
     };
 
+    static constexpr int AGE_BUCKETS = MAX_AGE - MIN_AGE + 1;
+
     std::map<std::string, Employee> employees;
 
+    /**
+     * @brief Secondary index: the names of all employees of age (MIN_AGE + i) live in bucket i.
+     *
+     * Must be kept in sync with `employees`; only insertEmployee() and eraseEmployee() touch it.
+     */
+    std::array<std::unordered_set<std::string>, AGE_BUCKETS> employeesByAge;
+
+    /**
+     * @brief Columnar copy of age, salary and gender used by aggregate queries.
+     *
+     * Kept in sync the same way as `employeesByAge`, plus setSalary() for salary changes.
+     */
+    EmployeeColumns columns;
+
+    /**
+     * @brief Prefix counts and substring search over the names, kept in sync like `columns`.
+     */
+    NameIndex nameIndex;
+
+    std::ofstream journal;
+    size_t journalRecords{0};  ///< Records appended since the last snapshot
+    bool binarySnapshot{false};  ///< True if the snapshot lives in BINARY_DATABASE_PATH
+
+    /**
+     * @brief Inserts an employee into the map, the age index and the columns, replacing any
+     * employee with the same name.
+     * @param emp The employee to insert. Its age must be valid.
+     */
+    void insertEmployee(Employee emp) {
+        auto it = employees.find(emp.name);
+        if (it != employees.end()) eraseEmployee(it);
+        employeesByAge[emp.age - MIN_AGE].insert(emp.name);
+        columns.insert(emp.name, emp.age, emp.salary, emp.gender);
+        nameIndex.insert(emp.name);
+        std::string name = emp.name;
+        employees[name] = std::move(emp);
+    }
+
+    /**
+     * @brief Removes an employee from the map, the age index and the columns.
+     * @param it Iterator to the employee to remove.
+     */
+    void eraseEmployee(std::map<std::string, Employee>::iterator it) {
+        employeesByAge[it->second.age - MIN_AGE].erase(it->first);
+        columns.erase(it->first);
+        nameIndex.erase(it->first);
+        employees.erase(it);
+    }
+
+    /**
+     * @brief Changes the salary of an employee in the map and the columns.
+     * @param it Iterator to the employee to update.
+     * @param salary The new salary.
+     */
+    void setSalary(std::map<std::string, Employee>::iterator it, int salary) {
+        it->second.salary = salary;
+        columns.setSalary(it->first, salary);
+    }
+
+    /**
+     * @brief Reads an age range from stdin, clamped to [MIN_AGE, MAX_AGE].
+     * @return The pair {start, end} with start <= end; empty (start > end) if it misses every age.
+     */
+    std::pair<int, int> readAgeRange() {
+        int start = Sefn::readValidatedInput<int>("Enter lower limit: ");
+        int end = Sefn::readValidatedInput<int>("Enter upper limit: ");
+        if (end < start) std::swap(start, end);
+        return {std::max(start, MIN_AGE), std::min(end, MAX_AGE)};
+    }
+
     /**
      * @brief Reads an employee name from stdin.
      * @return The trimmed name.
@@ -235,21 +226,198 @@ class EmployeeSystem {
      */
     void addEmployee() {
         std::string name = readNewUniqueName();
-        employees[name] = Employee(name, readAge(), readSalary(), readGender());
+        int age = readAge();
+        int salary = readSalary();
+        char gender = readGender();
+        Employee emp(name, age, salary, gender);
+        appendToJournal(std::string{JOURNAL_ADD, Employee::DELIM} + emp.toString());
+        insertEmployee(std::move(emp));
+    }
+
+    /**
+     * @brief Pauses after every PAGE_SIZE printed items and asks whether to go on.
+     * @param printed How many items have been printed so far.
+     * @return True to print the next item, false if the user stopped.
+     */
+    bool continuePaging(size_t printed) {
+        if (printed == 0 || printed % PAGE_SIZE != 0) return true;
+        return Sefn::readValidatedInput<bool>("-- Show more? (0 or 1): ");
+    }
+
+    /**
+     * @brief Prints one employee as a single table line.
+     */
+    static void printTableRow(const std::string& name, int age, int salary, char gender) {
+        std::cout << "\t" << std::left << std::setw(25) << name << std::right << std::setw(5) << age
+                  << std::setw(10) << salary << std::setw(4) << gender << "\n";
+    }
+
+    /**
+     * @brief Prints one column row as a single table line.
+     */
+    void printReportRow(size_t row) const {
+        printTableRow(columns.nameAt(row), columns.ageAt(row), columns.salaryAt(row),
+                      columns.genderAt(row));
+    }
+
+    /**
+     * @brief Prints the employees with the given names as table lines.
+     */
+    void printNamedRows(const std::vector<std::string>& names) const {
+        for (const auto& name : names) {
+            const Employee& emp = employees.at(name);
+            printTableRow(emp.name, emp.age, emp.salary, emp.gender);
+        }
+    }
+
+    /**
+     * @brief Prints names close to one that does not exist: the names sharing its longest
+     * matching prefix.
+     */
+    void suggestNames(const std::string& name) const {
+        size_t matched = nameIndex.matchedPrefixLength(name);
+        if (matched < NameIndex::GRAM) return;
+        auto suggestions = prefixMatches(employees, name.substr(0, matched), MAX_SUGGESTIONS);
+        std::cout << "Did you mean:\n";
+        for (const std::string* suggestion : suggestions) std::cout << "\t" << *suggestion << "\n";
+    }
+
+    /**
+     * @brief Searches the names by prefix and by substring and prints the best matches of each.
+     *
+     * If no name starts with the text, the longest prefix of it that does match is used instead.
+     */
+    void searchEmployees() {
+        std::string text = readEmployeeName();
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (text.empty()) {
+            std::cout << "\nNothing to search for!\n";
+            return;
+        }
+        auto startTime = Helper::Clock::now();
+
+        std::string prefix = text;
+        size_t count = nameIndex.countPrefix(prefix);
+        if (count == 0) {
+            prefix.resize(nameIndex.matchedPrefixLength(text));
+            count = prefix.empty() ? 0 : nameIndex.countPrefix(prefix);
+            std::cout << "\nNo name starts with \"" << text << "\".";
+            if (count > 0) std::cout << " Closest prefix: \"" << prefix << "\".";
+            std::cout << "\n";
+        }
+        if (count > 0) {
+            auto matches = prefixMatches(employees, prefix, SEARCH_LIMIT);
+            std::cout << "\n" << count << " name(s) start with \"" << prefix << "\":\n";
+            std::vector<std::string> names;
+            for (const std::string* match : matches) names.push_back(*match);
+            printNamedRows(names);
+        }
+
+        NameIndex::SearchResult contained = nameIndex.substringSearch(text, SEARCH_LIMIT);
+        std::cout << "\n" << contained.total << " name(s) contain \"" << text << "\":\n";
+        printNamedRows(contained.names);
+        if (contained.total > contained.names.size()) {
+            std::cout << "\t(showing the best " << contained.names.size() << ")\n";
+        }
+        Helper::printElapsed(startTime);
     }
 
     /**
-     * @brief Prints all employees in the system.
+     * @brief Prints all employees in the system, one page at a time.
      */
     void printEmployees() {
         std::cout << "\n******************\n";
+        size_t printed = 0;
         for (const auto& [name, emp] : employees) {
+            if (!continuePaging(printed++)) break;
             emp.print();
             std::cout << "\n";
         }
         std::cout << "******************\n";
     }
 
+    /**
+     * @brief Prints ranked rows as a table, one page at a time.
+     */
+    void printReportRows(const std::vector<size_t>& rows) {
+        std::cout << "\t" << std::left << std::setw(25) << "Name" << std::right << std::setw(5)
+                  << "Age" << std::setw(10) << "Salary" << std::setw(4) << "G" << "\n";
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (!continuePaging(i)) break;
+            printReportRow(rows[i]);
+        }
+    }
+
+    /**
+     * @brief Prints p50/p90/p99 salaries for each gender and overall.
+     */
+    void printSalaryPercentiles(const EmployeeReports& reports) {
+        static const std::vector<double> percents{50, 90, 99};
+        std::cout << "\t" << std::left << std::setw(8) << "Gender" << std::right << std::setw(10)
+                  << "Count" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10)
+                  << "p99" << "\n";
+        for (char gender : {'F', 'M', AggregateQuery::ANY_GENDER}) {
+            size_t count = 0;
+            std::vector<int> values = reports.salaryPercentiles(gender, percents, count);
+            std::cout << "\t" << std::left << std::setw(8)
+                      << (gender == AggregateQuery::ANY_GENDER ? std::string("All")
+                                                               : std::string(1, gender))
+                      << std::right << std::setw(10) << count;
+            for (int value : values) std::cout << std::setw(10) << value;
+            std::cout << "\n";
+        }
+    }
+
+    /**
+     * @brief Shows the reports menu: top earners, youngest employees and salary percentiles.
+     */
+    void showReports() {
+        std::cout << "\t1) Top K earners\n"
+                  << "\t2) Youngest K employees\n"
+                  << "\t3) Salary percentiles by gender\n";
+        int choice = Sefn::readValidatedInput<int>(
+            "Enter report: ", 0, [](int c) { return c >= 1 && c <= 3; },
+            "\nReport must be between 1 and 3. Try again\n");
+
+        EmployeeReports reports(columns);
+        if (choice == 3) {
+            auto startTime = Helper::Clock::now();
+            printSalaryPercentiles(reports);
+            Helper::printElapsed(startTime);
+            return;
+        }
+
+        int k = Sefn::readValidatedInput<int>("Enter K: ", 0, [](int v) { return v > 0; },
+                                              "\nK must be positive. Try again\n");
+        auto startTime = Helper::Clock::now();
+        std::vector<size_t> rows = choice == 1 ? reports.topEarners(k) : reports.youngest(k);
+        std::cout << "Computed " << rows.size() << " row(s) ";
+        Helper::printElapsed(startTime);
+        printReportRows(rows);
+    }
+
+    /**
+     * @brief Prints the employees within a specified age range, youngest first.
+     *
+     * Only the age buckets inside the range are visited.
+     */
+    void printEmployeesByAgeRange() {
+        auto [start, end] = readAgeRange();
+        auto startTime = Helper::Clock::now();
+        size_t found = 0;
+        std::cout << "\n******************\n";
+        for (int age = start; age <= end; ++age) {
+            for (const auto& name : employeesByAge[age - MIN_AGE]) {
+                employees.at(name).print();
+                std::cout << "\n";
+                ++found;
+            }
+        }
+        std::cout << "******************\n" << found << " employee(s) found ";
+        Helper::printElapsed(startTime);
+    }
+
     /**
      * @brief Deletes an employee by name.
      * @param name The name of the employee to delete.
@@ -258,30 +426,278 @@ class EmployeeSystem {
         auto it = employees.find(name);
         if (it == employees.end()) {
             std::cout << "\nThis name does not exist!\n";
+            suggestNames(name);
             return;
         }
-        employees.erase(it);
+        eraseEmployee(it);
+        appendToJournal(std::string{JOURNAL_DELETE, Employee::DELIM} + name);
     }
 
     /**
      * @brief Deletes employees within a specified age range.
+     *
+     * Whole age buckets are dropped, so the cost depends on the removed rows only.
      */
     void deleteEmployeesByAgeRange() {
-        int start = Sefn::readValidatedInput<int>("Enter lower limit: ");
-        int end = Sefn::readValidatedInput<int>("Enter upper limit: ");
-        if (end < start) std::swap(start, end);
+        auto [start, end] = readAgeRange();
+        auto startTime = Helper::Clock::now();
+        size_t removed = 0;
+        for (int age = start; age <= end; ++age) {
+            auto& bucket = employeesByAge[age - MIN_AGE];
+            for (const auto& name : bucket) {
+                employees.erase(name);
+                columns.erase(name);
+                nameIndex.erase(name);
+                appendToJournal(std::string{JOURNAL_DELETE, Employee::DELIM} + name);
+            }
+            removed += bucket.size();
+            bucket.clear();
+        }
+        std::cout << removed << " employee(s) removed ";
+        Helper::printElapsed(startTime);
+    }
 
-        std::vector<std::string> keysToRemove;
-        for (const auto& [name, emp] : employees) {
-            if (emp.age >= start && emp.age <= end) {
-                keysToRemove.push_back(name);
+    /**
+     * @brief Parses every line of a slice of an import file.
+     * @param text The slice; it starts at a line start and ends after a line terminator or at EOF.
+     * @param delim The field delimiter.
+     * @param chunk Receives the valid rows and the numbers of the invalid lines.
+     */
+    static void parseImportChunk(std::string_view text, char delim, ImportChunk& chunk) {
+        while (!text.empty()) {
+            size_t eol = text.find('\n');
+            std::string_view line = text.substr(0, eol);
+            text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+            ++chunk.lines;
+
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (Helper::trimmed(line).empty()) continue;
+
+            Employee emp;
+            if (Employee::parseRow(line, delim, emp)) {
+                chunk.rows.push_back(std::move(emp));
+            } else {
+                chunk.invalidLines.push_back(chunk.lines);
+            }
+        }
+    }
+
+    /**
+     * @brief Splits an import file into line-aligned slices, one per worker thread.
+     * @return The slice boundaries: slice i is [bounds[i], bounds[i + 1]).
+     */
+    static std::vector<size_t> splitImportText(std::string_view text) {
+        size_t workers = std::max(1u, std::thread::hardware_concurrency());
+        workers = std::max<size_t>(1, std::min(workers, text.size() / MIN_IMPORT_CHUNK_BYTES));
+
+        std::vector<size_t> bounds{0};
+        for (size_t i = 1; i < workers; ++i) {
+            size_t eol = text.find('\n', std::max(bounds.back(), i * text.size() / workers));
+            if (eol == std::string_view::npos) break;
+            bounds.push_back(eol + 1);
+        }
+        bounds.push_back(text.size());
+        return bounds;
+    }
+
+    /**
+     * @brief Imports employees in bulk from a delimited file.
+     *
+     * The file is read in one go, split into line-aligned chunks and parsed and validated on
+     * one thread per chunk. The chunks are then merged in file order: names that already exist
+     * (in the system or earlier in the file) are reported as duplicates and skipped. A fresh
+     * snapshot is written at the end instead of journaling every imported row; if that fails,
+     * the rows are journaled after all.
+     */
+    void bulkImport() {
+        std::string path;
+        std::cout << "Enter file path: ";
+        std::getline(std::cin >> std::ws, path);
+        Helper::trim(path);
+        char delim = Sefn::readValidatedInput<char>(
+            "Enter field delimiter (e.g. , or |): ", 0,
+            [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != ' '; },
+            "\nInvalid delimiter. Try again\n");
+
+        auto startTime = Helper::Clock::now();
+        std::ifstream file(path, std::ios::binary);
+        if (file.fail()) {
+            std::cout << "\nCould not open " << path << "\n";
+            return;
+        }
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        file.close();
+
+        std::vector<size_t> bounds = splitImportText(text);
+        std::vector<ImportChunk> chunks(bounds.size() - 1);
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            std::string_view slice(text.data() + bounds[i], bounds[i + 1] - bounds[i]);
+            workers.emplace_back(parseImportChunk, slice, delim, std::ref(chunks[i]));
+        }
+        for (auto& worker : workers) worker.join();
+
+        // A header row ("name,age,...") is expected to fail validation; don't report it
+        std::string header = std::string("name") + delim;
+        if (!chunks.empty() && !chunks[0].invalidLines.empty() &&
+            chunks[0].invalidLines[0] == 1 && text.compare(0, header.size(), header) == 0) {
+            chunks[0].invalidLines.erase(chunks[0].invalidLines.begin());
+        }
+
+        size_t parsedRows = 0;
+        for (const auto& chunk : chunks) parsedRows += chunk.rows.size();
+        columns.reserve(columns.size() + parsedRows);
+        nameIndex.reserve(nameIndex.size() + parsedRows);
+
+        size_t lineBase = 0;
+        std::vector<std::string> imported, duplicates;
+        std::vector<size_t> invalidLines;
+        for (auto& chunk : chunks) {
+            for (size_t line : chunk.invalidLines) invalidLines.push_back(lineBase + line);
+            lineBase += chunk.lines;
+            for (auto& emp : chunk.rows) {
+                if (employees.count(emp.name)) {
+                    duplicates.push_back(std::move(emp.name));
+                } else {
+                    imported.push_back(emp.name);
+                    insertEmployee(std::move(emp));
+                }
+            }
+            chunk = ImportChunk();  // release the parsed rows early
+        }
+        bool saved = imported.empty() || compactDatabase();
+        if (!saved) {
+            for (const auto& name : imported) {
+                appendToJournal(std::string{JOURNAL_ADD, Employee::DELIM} +
+                                employees.at(name).toString());
+            }
+        }
+
+        std::cout << "\nImported " << imported.size() << " employee(s) using " << workers.size()
+                  << " thread(s) ";
+        Helper::printElapsed(startTime);
+        if (!saved) {
+            std::cout << (journal.good() ? "Could not write a fresh snapshot; the imported rows "
+                                           "were saved to the journal instead\n"
+                                         : "Could not save the imported rows!\n");
+        }
+        if (!duplicates.empty()) {
+            std::cout << duplicates.size() << " duplicate name(s) skipped:\n";
+            for (size_t i = 0; i < duplicates.size() && i < MAX_REPORTED_IMPORT_ISSUES; ++i) {
+                std::cout << "\t" << duplicates[i] << "\n";
             }
+            if (duplicates.size() > MAX_REPORTED_IMPORT_ISSUES) std::cout << "\t...\n";
         }
+        if (!invalidLines.empty()) {
+            std::cout << invalidLines.size() << " invalid row(s) skipped, at line(s):";
+            for (size_t i = 0; i < invalidLines.size() && i < MAX_REPORTED_IMPORT_ISSUES; ++i) {
+                std::cout << " " << invalidLines[i];
+            }
+            std::cout << (invalidLines.size() > MAX_REPORTED_IMPORT_ISSUES ? " ...\n" : "\n");
+        }
+    }
+
+    /**
+     * @brief Applies a batch update to every matching employee in a single pass.
+     *
+     * New salaries are rounded and clamped to [MIN_SALARY, MAX_SALARY]; rows whose expression
+     * is not a number (e.g. 0 / 0) keep their salary.
+     * @param update The parsed command.
+     * @return How many rows matched, changed and were clamped.
+     */
+    BatchUpdateStats applyBatchUpdate(const BatchUpdate& update) {
+        BatchUpdateStats stats;
+        for (auto it = employees.begin(); it != employees.end(); ++it) {
+            const Employee& emp = it->second;
+            EmployeeFields fields{emp.age, emp.salary, emp.gender};
+            if (!update.matches(fields)) continue;
+            ++stats.matched;
+
+            double value = update.evaluate(fields);
+            if (std::isnan(value)) continue;
+            if (value < MIN_SALARY || value > MAX_SALARY) ++stats.clamped;
+            value = std::clamp(value, double(MIN_SALARY), double(MAX_SALARY));
+            int salary = static_cast<int>(std::lround(value));
+            if (salary != emp.salary) {
+                setSalary(it, salary);
+                ++stats.changed;
+                stats.changedNames.push_back(it->first);
+            }
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Reads a batch salary update command and applies it.
+     *
+     * The change set is journaled as its effect, one salary record per changed row in a single
+     * group, so replaying it on a snapshot that already holds it changes nothing.
+     */
+    void batchUpdateSalaries() {
+        std::cout << "Syntax: salary = <expression> [where <condition>]\n"
+                  << "Fields: age, salary, gender ('M' or 'F'); operators: + - * / "
+                     "< <= > >= == != and or not min(a, b) max(a, b)\n"
+                  << "Example: salary = salary * 1.07 where age >= 25 and age <= 35\n"
+                  << "Enter command: ";
+        std::string command;
+        std::getline(std::cin >> std::ws, command);
+        Helper::trim(command);
+
+        try {
+            BatchUpdate update(command);
+            auto startTime = Helper::Clock::now();
+            BatchUpdateStats stats = applyBatchUpdate(update);
+            std::vector<std::string> records;
+            records.reserve(stats.changedNames.size());
+            for (const std::string& name : stats.changedNames) {
+                records.push_back(salaryRecord(name, employees.at(name).salary));
+            }
+            appendGroupToJournal(records);
+            std::cout << "\n" << stats.matched << " employee(s) matched, " << stats.changed
+                      << " updated, " << stats.clamped << " clamped ";
+            Helper::printElapsed(startTime);
+        } catch (const std::invalid_argument& e) {
+            std::cout << "\nInvalid command: " << e.what() << "\n";
+        }
+    }
+
+    /**
+     * @brief Reads the predicate of an aggregate query from stdin.
+     * @return The query; salary bounds are swapped if given in the wrong order.
+     */
+    AggregateQuery readAggregateQuery() {
+        AggregateQuery query;
+        std::cout << "Age range:\n";
+        std::tie(query.minAge, query.maxAge) = readAgeRange();
+        query.gender = Sefn::readValidatedInput<char>(
+            "Enter gender (M, F or * for any): ", 0,
+            [](char g) { return Employee::isValidGender(g) || g == AggregateQuery::ANY_GENDER; },
+            "\nInvalid gender. Try again\n");
+        std::cout << "Salary range:\n";
+        query.minSalary = Sefn::readValidatedInput<int>("Enter lower limit: ");
+        query.maxSalary = Sefn::readValidatedInput<int>("Enter upper limit: ");
+        if (query.maxSalary < query.minSalary) std::swap(query.minSalary, query.maxSalary);
+        return query;
+    }
+
+    /**
+     * @brief Prints count, sum, min, max and average salary of the employees matching a query.
+     *
+     * Runs as a single scan over the salary, age and gender columns.
+     */
+    void aggregateSalaries() {
+        AggregateQuery query = readAggregateQuery();
+        auto startTime = Helper::Clock::now();
+        AggregateResult result = columns.aggregate(query);
 
-        for (const auto& key : keysToRemove) {
-            employees.erase(key);
+        std::cout << "\nMatching employees: " << result.count << "\n";
+        if (result.count > 0) {
+            std::cout << "Total salary: " << result.sum << "\n"
+                      << "Min salary: " << result.min << "\n"
+                      << "Max salary: " << result.max << "\n"
+                      << "Average salary: " << result.average() << "\n";
         }
-        std::cout << keysToRemove.size() << " employee(s) removed\n";
+        Helper::printElapsed(startTime);
     }
 
     /**
@@ -292,40 +708,269 @@ class EmployeeSystem {
         auto it = employees.find(name);
         if (it == employees.end()) {
             std::cout << "\nThis name does not exist!\n";
+            suggestNames(name);
             return;
         }
-        it->second.salary = readSalary();
+        setSalary(it, readSalary());
+        appendToJournal(salaryRecord(name, it->second.salary));
+    }
+
+    /**
+     * @brief The journal record setting an employee's salary.
+     */
+    static std::string salaryRecord(const std::string& name, int salary) {
+        return std::string{JOURNAL_SALARY, Employee::DELIM} + name + Employee::DELIM +
+               std::to_string(salary);
+    }
+
+    /**
+     * @brief Appends a single change record to the journal.
+     * @param record The record, tagged with one of the JOURNAL_* characters.
+     */
+    void appendToJournal(const std::string& record) {
+        journal << record << '\n' << std::flush;
+        ++journalRecords;
+    }
+
+    /**
+     * @brief Appends records that must be replayed all together or not at all, in one write.
+     *
+     * They are preceded by a group record counting them; replay drops a group cut short by a
+     * crash.
+     */
+    void appendGroupToJournal(const std::vector<std::string>& records) {
+        if (records.empty()) return;
+        std::string group = std::string{JOURNAL_GROUP, Employee::DELIM} +
+                            std::to_string(records.size()) + '\n';
+        for (const std::string& record : records) group += record + '\n';
+        journal << group << std::flush;
+        journalRecords += records.size();
+    }
+
+    /**
+     * @brief Applies one journal record to the in-memory state.
+     * @param record The record as read from the journal file.
+     * @return True if the record was well formed, false otherwise.
+     */
+    bool replayJournalRecord(const std::string& record) {
+        if (record.size() < 3 || record[1] != Employee::DELIM) return false;
+        std::string payload = record.substr(2);
+
+        if (record[0] == JOURNAL_ADD) {
+            Employee emp(payload);
+            if (!emp.isValid()) return false;
+            insertEmployee(std::move(emp));
+        } else if (record[0] == JOURNAL_DELETE) {
+            auto it = employees.find(payload);
+            if (it != employees.end()) eraseEmployee(it);
+        } else if (record[0] == JOURNAL_SALARY) {
+            size_t delimPos = payload.rfind(Employee::DELIM);
+            if (delimPos == std::string::npos) return false;
+            auto it = employees.find(payload.substr(0, delimPos));
+            if (it == employees.end()) return false;
+            try {
+                setSalary(it, std::stoi(payload.substr(delimPos + 1)));
+            } catch (const std::exception&) {
+                return false;
+            }
+        } else if (record[0] == JOURNAL_BATCH) {
+            // Not idempotent: only written by versions that journaled the command itself
+            try {
+                applyBatchUpdate(BatchUpdate(payload));
+            } catch (const std::invalid_argument&) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        return true;
     }
 
     /**
-     * @brief Loads employee data from the database file.
+     * @brief Loads the snapshot file, replays the journal on top of it and opens the journal for
+     * appending.
      */
     void loadDatabase() {
+        employees.clear();
+        for (auto& bucket : employeesByAge) bucket.clear();
+        columns.clear();
+        nameIndex.clear();
+        loadSnapshot();
+
+        std::ifstream journalIn(JOURNAL_PATH);
+        std::string record;
+        journalRecords = 0;
+        std::streampos recordStart = journalIn.tellg();
+        std::optional<std::streampos> tornGroup;  ///< Where a group cut short by a crash starts
+        for (; std::getline(journalIn, record); recordStart = journalIn.tellg()) {
+            if (record.empty()) continue;
+            int groupSize = 0;
+            if (record.size() > 2 && record[0] == JOURNAL_GROUP && record[1] == Employee::DELIM &&
+                Helper::parseInt(std::string_view(record).substr(2), groupSize) && groupSize > 0) {
+                std::vector<std::string> group;
+                while (group.size() < static_cast<size_t>(groupSize) &&
+                       std::getline(journalIn, record)) {
+                    group.push_back(record);
+                }
+                if (group.size() < static_cast<size_t>(groupSize)) {
+                    std::cerr << "Warning: Skipping incomplete journal group of " << groupSize
+                              << " record(s)\n";
+                    tornGroup = recordStart;
+                    break;
+                }
+                for (const std::string& member : group) {
+                    if (!replayJournalRecord(member)) {
+                        std::cerr << "Warning: Skipping corrupted journal record: " << member
+                                  << "\n";
+                    }
+                }
+                journalRecords += group.size();
+                continue;
+            }
+            if (!replayJournalRecord(record)) {
+                std::cerr << "Warning: Skipping corrupted journal record: " << record << "\n";
+            }
+            ++journalRecords;
+        }
+        journalIn.close();
+        if (tornGroup) {
+            // Cut it off, or the records appended next would be read as its missing members
+            std::error_code ec;
+            std::filesystem::resize_file(JOURNAL_PATH, static_cast<uintmax_t>(*tornGroup), ec);
+            if (ec) std::cerr << "\nCould not truncate " << JOURNAL_PATH << ": " << ec.message();
+        }
+
+        journal.open(JOURNAL_PATH, std::ios::app);
+        if (journal.fail()) {
+            std::cerr << "\nCould not open " << JOURNAL_PATH << " for writing!\n";
+        }
+    }
+
+    /**
+     * @brief Loads employee data from the snapshot file.
+     */
+    void loadSnapshot() {
+        binarySnapshot = std::filesystem::exists(BINARY_DATABASE_PATH);
+        if (binarySnapshot) {
+            loadBinarySnapshot();
+            return;
+        }
+
         std::ifstream data(DATABASE_PATH);
         if (data.fail()) return;
 
         std::string empStr;
-        employees.clear();
         while (std::getline(data, empStr) && !empStr.empty()) {
             Employee emp(empStr);
-            employees[emp.name] = emp;
+            if (!emp.isValid()) {
+                std::cerr << "Warning: Skipping invalid employee: " << empStr << "\n";
+                continue;
+            }
+            insertEmployee(std::move(emp));
         }
         data.close();
     }
 
     /**
-     * @brief Saves employee data to the database file.
+     * @brief Loads employee data from the binary snapshot file.
+     *
+     * The file is memory-mapped and every row is read from a fixed offset; only validation and
+     * the map and index insertions remain per row.
+     * @throws std::runtime_error if the file cannot be opened or is not a snapshot. Starting
+     * with an empty roster instead would overwrite it at the next compaction.
      */
-    void updateDatabase() {
-        std::ofstream data(DATABASE_PATH);
-        if (data.fail()) {
-            std::cerr << "\nCould not open " << DATABASE_PATH << " for writing!\n";
-            return;
+    void loadBinarySnapshot() {
+        BinarySnapshot::Reader reader;
+        std::string error;
+        if (!reader.open(BINARY_DATABASE_PATH, error)) {
+            throw std::runtime_error(std::string("Could not load ") + BINARY_DATABASE_PATH +
+                                     ": " + error + ". Repair or remove it to start.");
+        }
+
+        columns.reserve(reader.size());
+        nameIndex.reserve(reader.size());
+        BinarySnapshot::RowView row;
+        for (size_t i = 0; i < reader.size(); ++i) {
+            Employee emp;  // invalid unless the row decodes
+            if (reader.row(i, row)) {
+                emp = Employee(std::string(row.name), row.age, row.salary, row.gender);
+            }
+            if (!emp.isValid()) {
+                std::cerr << "Warning: Skipping corrupted snapshot row " << i << "\n";
+                continue;
+            }
+            insertEmployee(std::move(emp));
         }
+    }
+
+    /**
+     * @brief Writes all employees to a text snapshot file.
+     * @return True on success.
+     */
+    bool writeTextSnapshot(const std::string& path) const {
+        std::ofstream data(path);
+        if (data.fail()) return false;
         for (const auto& [name, emp] : employees) {
             data << emp.toString() << "\n";
         }
         data.close();
+        return !data.fail();
+    }
+
+    /**
+     * @brief Writes all employees to a binary snapshot file.
+     * @return True on success.
+     */
+    bool writeBinarySnapshot(const std::string& path) const {
+        std::vector<const Employee*> rows;
+        rows.reserve(employees.size());
+        for (const auto& [name, emp] : employees) rows.push_back(&emp);
+        return BinarySnapshot::write(path, rows);
+    }
+
+    /**
+     * @brief Writes a fresh snapshot and truncates the journal.
+     *
+     * The snapshot is written to a temporary file, synced to disk and renamed over the old one,
+     * and the rename is synced before the journal is truncated. A crash or power cut mid-way
+     * therefore leaves either the previous snapshot and the journal, or the new snapshot.
+     * @return True if the snapshot was replaced; on failure the journal is kept.
+     */
+    bool compactDatabase() {
+        std::string path = binarySnapshot ? BINARY_DATABASE_PATH : DATABASE_PATH;
+        std::string tmpPath = path + ".tmp";
+        if (!(binarySnapshot ? writeBinarySnapshot(tmpPath) : writeTextSnapshot(tmpPath)) ||
+            !Helper::syncToDisk(tmpPath)) {
+            std::cerr << "\nCould not write " << tmpPath << "!\n";
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec) {
+            std::cerr << "\nCould not replace " << path << ": " << ec.message() << "\n";
+            return false;
+        }
+        std::filesystem::path directory = std::filesystem::absolute(path, ec).parent_path();
+        if (ec || !Helper::syncToDisk(directory.string())) {
+            // The new snapshot may not survive a power cut yet: keep the journal
+            std::cerr << "\nCould not sync " << path << "; keeping the journal\n";
+            return false;
+        }
+        journal.close();
+        journal.open(JOURNAL_PATH, std::ios::trunc);
+        journalRecords = 0;
+        return true;
+    }
+
+    /**
+     * @brief Compacts the journal once it outgrows the snapshot, keeping compaction amortized
+     * O(1) per change.
+     */
+    void compactIfNeeded() {
+        if (journalRecords >= std::max(MIN_COMPACTION_RECORDS, employees.size())) {
+            compactDatabase();
+        }
     }
 
    public:
@@ -338,6 +983,7 @@ class EmployeeSystem {
      * @brief Starts the employee system application loop.
      *
      * Displays the menu and processes user input until exit is chosen.
+     * @throws std::runtime_error if the database cannot be loaded.
      */
     void run() {
         loadDatabase();
@@ -348,7 +994,13 @@ class EmployeeSystem {
                       << "\t3) Delete by age range\n"
                       << "\t4) Update salary by name\n"
                       << "\t5) Delete an employee by name\n"
-                      << "\t6) Exit\n";
+                      << "\t6) Print employees by age range\n"
+                      << "\t7) Aggregate salaries\n"
+                      << "\t8) Bulk import from file\n"
+                      << "\t9) Batch salary update\n"
+                      << "\t10) Reports\n"
+                      << "\t11) Search by name\n"
+                      << "\t12) Exit\n";
 
             int choice = Sefn::readValidatedInput<int>("Enter your choice: ");
             if (choice == 1) {
@@ -362,18 +1014,36 @@ class EmployeeSystem {
             } else if (choice == 5) {
                 deleteEmployeeByName(readEmployeeName());
             } else if (choice == 6) {
+                printEmployeesByAgeRange();
+            } else if (choice == 7) {
+                aggregateSalaries();
+            } else if (choice == 8) {
+                bulkImport();
+            } else if (choice == 9) {
+                batchUpdateSalaries();
+            } else if (choice == 10) {
+                showReports();
+            } else if (choice == 11) {
+                searchEmployees();
+            } else if (choice == 12) {
+                if (journalRecords > 0) compactDatabase();
                 std::cout << "\n*******Bye!*******\n";
                 break;
             } else {
                 std::cout << "Invalid choice. Please try again.\n";
             }
-            updateDatabase();
+            compactIfNeeded();
         }
     }
 };
 
 int main() {
     EmployeeSystem system;
-    system.run();
+    try {
+        system.run();
+    } catch (const std::runtime_error& e) {
+        std::cerr << "\n" << e.what() << "\n";
+        return 1;
+    }
     return 0;
 }
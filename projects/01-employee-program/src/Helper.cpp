@@ -0,0 +1,64 @@
+#include "Helper.hpp"
+
+#include <charconv>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Helper {
+const std::string WHITESPACE = " \n\r\t\f\v";
+
+void lTrim(std::string& s) {
+    size_t start = s.find_first_not_of(WHITESPACE);
+    if (start == std::string::npos) {
+        s.clear();
+    } else {
+        s.erase(0, start);
+    }
+}
+
+void rTrim(std::string& s) {
+    size_t end = s.find_last_not_of(WHITESPACE);
+    if (end == std::string::npos) {
+        s.clear();
+    } else {
+        s.erase(end + 1);
+    }
+}
+
+void trim(std::string& s) {
+    rTrim(s);
+    lTrim(s);
+}
+
+std::string_view trimmed(std::string_view s) {
+    size_t start = s.find_first_not_of(WHITESPACE);
+    if (start == std::string_view::npos) return {};
+    return s.substr(start, s.find_last_not_of(WHITESPACE) - start + 1);
+}
+
+bool parseInt(std::string_view s, int& value) {
+    auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    return ec == std::errc() && end == s.data() + s.size();
+}
+
+bool syncToDisk(const std::string& path) {
+#if defined(_WIN32)
+    (void)path;
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = fsync(fd) == 0;
+    return close(fd) == 0 && synced;
+#endif
+}
+
+void printElapsed(Clock::time_point start) {
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    std::cout << "(took " << elapsed.count() << " ms)\n";
+}
+}  // namespace Helper
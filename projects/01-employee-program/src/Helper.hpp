@@ -0,0 +1,63 @@
+/**
+ * @file Helper.hpp
+ * @brief Utility functions for string manipulation, conversion and timing.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+/**
+ * @namespace Helper
+ * @brief Utility functions for string manipulation and conversion.
+ */
+namespace Helper {
+extern const std::string WHITESPACE;
+
+/**
+ * @brief Trims leading whitespace from a string.
+ * @param s The string to trim.
+ */
+void lTrim(std::string& s);
+
+/**
+ * @brief Trims trailing whitespace from a string.
+ * @param s The string to trim.
+ */
+void rTrim(std::string& s);
+
+/**
+ * @brief Trims both leading and trailing whitespace from a string.
+ * @param s The string to trim.
+ */
+void trim(std::string& s);
+
+/**
+ * @brief Returns a view of a string without its leading and trailing whitespace.
+ * @param s The string to trim.
+ */
+std::string_view trimmed(std::string_view s);
+
+/**
+ * @brief Parses a whole string_view as a decimal int.
+ * @return True if the view held exactly one in-range integer.
+ */
+bool parseInt(std::string_view s, int& value);
+
+/**
+ * @brief Forces a file's contents, or a directory's entries, down to the disk.
+ * @param path The file or directory; it must exist.
+ * @return True on success (always on platforms without fsync).
+ */
+bool syncToDisk(const std::string& path);
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Prints the time elapsed since a given starting point.
+ * @param start The time point the measured operation started at.
+ */
+void printElapsed(Clock::time_point start);
+}  // namespace Helper
@@ -0,0 +1,43 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only view of a whole file, memory-mapped where the platform supports it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class MappedFile
+ * @brief Maps a file read-only with mmap (POSIX) or reads it into memory (other platforms).
+ *
+ * The contents stay valid for the lifetime of the object.
+ */
+class MappedFile {
+    const char* bytes{nullptr};
+    size_t length{0};
+    bool mapped{false};
+    std::vector<char> buffer;  ///< Owns the contents when the file could not be mapped
+
+    void release();
+
+   public:
+    MappedFile() = default;
+
+    /**
+     * @brief Opens and maps a file.
+     * @param path The file to open.
+     * @return True on success, false if the file could not be opened or mapped.
+     */
+    bool open(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { release(); }
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
@@ -0,0 +1,282 @@
+#include "NameIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <queue>
+#include <tuple>
+
+namespace {
+/**
+ * @struct Match
+ * @brief A substring match; a smaller Match ranks higher.
+ */
+struct Match {
+    size_t pos;
+    size_t length;
+    const std::string* name;
+
+    bool operator<(const Match& other) const {
+        return std::tie(pos, length, *name) < std::tie(other.pos, other.length, *other.name);
+    }
+};
+}  // namespace
+
+void NameIndex::insert(const std::string& name) {
+    uint32_t slot = static_cast<uint32_t>(slots.size());
+    slots.push_back(name);
+    slotOf.emplace(name, slot);
+    indexGrams(slot);
+    trieInsert(name);
+}
+
+bool NameIndex::erase(const std::string& name) {
+    auto it = slotOf.find(name);
+    if (it == slotOf.end()) return false;
+
+    trieErase(name);
+    // The slot stays in the posting lists until the next rebuild; an empty name marks it dead.
+    std::string().swap(slots[it->second]);
+    slotOf.erase(it);
+    if (++deadSlots >= MIN_REBUILD_SLOTS && deadSlots > slotOf.size()) rebuildGrams();
+    return true;
+}
+
+void NameIndex::clear() {
+    nodes.assign(1, TrieNode{});
+    freeNodes.clear();
+    slots.clear();
+    slotOf.clear();
+    postings.clear();
+    deadSlots = 0;
+}
+
+void NameIndex::reserve(size_t names) {
+    slots.reserve(names);
+    slotOf.reserve(names);
+}
+
+size_t NameIndex::countPrefix(std::string_view prefix) const {
+    uint32_t node = 0;
+    size_t pos = 0;
+    while (pos < prefix.size()) {
+        uint32_t child = findChild(node, prefix[pos]);
+        if (child == 0) return 0;
+        const std::string& label = nodes[child].label;
+        size_t n = std::min(label.size(), prefix.size() - pos);
+        if (label.compare(0, n, prefix.substr(pos, n)) != 0) return 0;
+        pos += n;
+        node = child;
+    }
+    return nodes[node].count;
+}
+
+size_t NameIndex::matchedPrefixLength(std::string_view text) const {
+    uint32_t node = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        uint32_t child = findChild(node, text[pos]);
+        if (child == 0) break;
+        const std::string& label = nodes[child].label;
+        size_t n = 0;
+        while (n < label.size() && pos + n < text.size() && label[n] == text[pos + n]) ++n;
+        pos += n;
+        if (n < label.size()) break;
+        node = child;
+    }
+    return pos;
+}
+
+NameIndex::SearchResult NameIndex::substringSearch(std::string_view text, size_t limit) const {
+    SearchResult result;
+    if (text.empty()) return result;
+
+    std::priority_queue<Match> worstOnTop;
+    auto consider = [&](const std::string& name) {
+        size_t pos = name.empty() ? std::string::npos : name.find(text);
+        if (pos == std::string::npos) return;
+        ++result.total;
+        Match match{pos, name.size(), &name};
+        if (worstOnTop.size() < limit) {
+            worstOnTop.push(match);
+        } else if (limit > 0 && match < worstOnTop.top()) {
+            worstOnTop.pop();
+            worstOnTop.push(match);
+        }
+    };
+
+    if (text.size() < GRAM) {
+        for (const auto& name : slots) consider(name);
+    } else {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (size_t pos = 0; pos + GRAM <= text.size(); ++pos) {
+            auto it = postings.find(gramKey(text, pos));
+            if (it == postings.end()) return result;
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) {
+            return std::make_pair(a->size(), a) < std::make_pair(b->size(), b);
+        });
+        lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+        // Start from the rarest trigram; probe much longer lists by binary search instead of
+        // walking them.
+        std::vector<uint32_t> candidates = *lists[0];
+        std::vector<uint32_t> next;
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+            const std::vector<uint32_t>& list = *lists[i];
+            next.clear();
+            if (candidates.size() * 16 < list.size()) {
+                std::copy_if(candidates.begin(), candidates.end(), std::back_inserter(next),
+                             [&list](uint32_t slot) {
+                                 return std::binary_search(list.begin(), list.end(), slot);
+                             });
+            } else {
+                std::set_intersection(candidates.begin(), candidates.end(), list.begin(),
+                                      list.end(), std::back_inserter(next));
+            }
+            candidates.swap(next);
+        }
+        for (uint32_t slot : candidates) consider(slots[slot]);
+    }
+
+    result.names.resize(worstOnTop.size());
+    for (size_t i = result.names.size(); i-- > 0; worstOnTop.pop()) {
+        result.names[i] = *worstOnTop.top().name;
+    }
+    return result;
+}
+
+uint32_t NameIndex::gramKey(std::string_view text, size_t pos) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+size_t NameIndex::childPosition(uint32_t node, char first) const {
+    const std::vector<uint32_t>& children = nodes[node].children;
+    return std::lower_bound(children.begin(), children.end(), first,
+                            [this](uint32_t child, char c) { return nodes[child].label[0] < c; }) -
+           children.begin();
+}
+
+uint32_t NameIndex::findChild(uint32_t node, char first) const {
+    size_t at = childPosition(node, first);
+    const std::vector<uint32_t>& children = nodes[node].children;
+    return at < children.size() && nodes[children[at]].label[0] == first ? children[at] : 0;
+}
+
+uint32_t NameIndex::newNode(std::string label) {
+    TrieNode node;
+    node.label = std::move(label);
+    if (freeNodes.empty()) {
+        nodes.push_back(std::move(node));
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+    uint32_t index = freeNodes.back();
+    freeNodes.pop_back();
+    nodes[index] = std::move(node);
+    return index;
+}
+
+void NameIndex::freeNode(uint32_t node) {
+    nodes[node] = TrieNode{};
+    freeNodes.push_back(node);
+}
+
+void NameIndex::mergeWithOnlyChild(uint32_t node) {
+    if (node == 0 || nodes[node].terminal || nodes[node].children.size() != 1) return;
+    uint32_t child = nodes[node].children[0];
+    nodes[node].label += nodes[child].label;
+    nodes[node].terminal = nodes[child].terminal;
+    nodes[node].children = std::move(nodes[child].children);
+    freeNode(child);
+}
+
+void NameIndex::trieInsert(std::string_view name) {
+    uint32_t node = 0;
+    size_t pos = 0;
+    ++nodes[0].count;
+    while (pos < name.size()) {
+        // Indices only: newNode() may reallocate `nodes`.
+        size_t at = childPosition(node, name[pos]);
+        if (at == nodes[node].children.size() ||
+            nodes[nodes[node].children[at]].label[0] != name[pos]) {
+            uint32_t leaf = newNode(std::string(name.substr(pos)));
+            nodes[leaf].count = 1;
+            nodes[leaf].terminal = true;
+            nodes[node].children.insert(nodes[node].children.begin() + at, leaf);
+            return;
+        }
+
+        uint32_t child = nodes[node].children[at];
+        size_t common = 0;
+        while (common < nodes[child].label.size() && pos + common < name.size() &&
+               nodes[child].label[common] == name[pos + common]) {
+            ++common;
+        }
+        if (common < nodes[child].label.size()) {
+            // Split the edge: the shared part becomes a new node above the old child.
+            uint32_t middle = newNode(nodes[child].label.substr(0, common));
+            nodes[middle].count = nodes[child].count;
+            nodes[middle].children.push_back(child);
+            nodes[child].label.erase(0, common);
+            nodes[node].children[at] = middle;
+            child = middle;
+        }
+        ++nodes[child].count;
+        pos += common;
+        node = child;
+    }
+    nodes[node].terminal = true;
+}
+
+bool NameIndex::trieErase(std::string_view name) {
+    std::vector<uint32_t> path{0};
+    size_t pos = 0;
+    while (pos < name.size()) {
+        uint32_t child = findChild(path.back(), name[pos]);
+        if (child == 0 || name.compare(pos, nodes[child].label.size(), nodes[child].label) != 0) {
+            return false;
+        }
+        pos += nodes[child].label.size();
+        path.push_back(child);
+    }
+    uint32_t node = path.back();
+    if (!nodes[node].terminal) return false;
+
+    for (uint32_t visited : path) --nodes[visited].count;
+    nodes[node].terminal = false;
+    if (node != 0 && nodes[node].count == 0) {
+        uint32_t parent = path[path.size() - 2];
+        auto& siblings = nodes[parent].children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+        freeNode(node);
+        mergeWithOnlyChild(parent);
+    } else {
+        mergeWithOnlyChild(node);
+    }
+    return true;
+}
+
+void NameIndex::indexGrams(uint32_t slot) {
+    const std::string& name = slots[slot];
+    for (size_t pos = 0; pos + GRAM <= name.size(); ++pos) {
+        std::vector<uint32_t>& list = postings[gramKey(name, pos)];
+        if (list.empty() || list.back() != slot) list.push_back(slot);
+    }
+}
+
+void NameIndex::rebuildGrams() {
+    std::vector<std::string> live;
+    live.reserve(slotOf.size());
+    for (auto& name : slots) {
+        if (!name.empty()) live.push_back(std::move(name));
+    }
+    slots = std::move(live);
+    postings.clear();
+    deadSlots = 0;
+    for (uint32_t slot = 0; slot < slots.size(); ++slot) {
+        slotOf[slots[slot]] = slot;
+        indexGrams(slot);
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file NameIndex.hpp
+ * @brief Prefix and substring search over employee names.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Lists the keys of a sorted map that start with a prefix, in alphabetical order.
+ * @param map The map to search.
+ * @param prefix The prefix to match.
+ * @param limit The maximum number of keys to return.
+ * @return Pointers to at most `limit` matching keys; O(log n + limit).
+ */
+template <typename Value>
+std::vector<const std::string*> prefixMatches(const std::map<std::string, Value>& map,
+                                              std::string_view prefix, size_t limit) {
+    std::vector<const std::string*> result;
+    for (auto it = map.lower_bound(std::string(prefix));
+         it != map.end() && result.size() < limit &&
+         it->first.compare(0, prefix.size(), prefix) == 0;
+         ++it) {
+        result.push_back(&it->first);
+    }
+    return result;
+}
+
+/**
+ * @class NameIndex
+ * @brief Search structures kept next to the sorted roster map.
+ *
+ * A compact (path-compressed) trie counts the names under any prefix and finds the longest
+ * prefix of a mistyped name that still matches something, both in O(prefix length). A trigram
+ * index answers substring queries: the posting lists of the query's trigrams are intersected
+ * and only the surviving candidates are checked with std::string::find.
+ */
+class NameIndex {
+   public:
+    static constexpr size_t GRAM = 3;  ///< Length of the indexed n-grams
+
+    /**
+     * @struct SearchResult
+     * @brief The best matches of a query and the total number of matches.
+     */
+    struct SearchResult {
+        std::vector<std::string> names;  ///< Best matches first
+        size_t total{0};                 ///< Every match, including the ones not returned
+    };
+
+    /**
+     * @brief Adds a name. The name must not be present already.
+     */
+    void insert(const std::string& name);
+
+    /**
+     * @brief Removes a name.
+     * @return True if the name was present, false otherwise.
+     */
+    bool erase(const std::string& name);
+
+    /**
+     * @brief Removes every name.
+     */
+    void clear();
+
+    /**
+     * @brief Reserves capacity for a number of names.
+     */
+    void reserve(size_t names);
+
+    size_t size() const { return slotOf.size(); }
+
+    /**
+     * @brief Counts the names starting with a prefix.
+     */
+    size_t countPrefix(std::string_view prefix) const;
+
+    /**
+     * @brief Length of the longest prefix of `text` that at least one name starts with.
+     */
+    size_t matchedPrefixLength(std::string_view text) const;
+
+    /**
+     * @brief Finds the names containing a substring.
+     *
+     * Matches are ranked by where the substring occurs (prefix matches first), then by name
+     * length (closest match first), then alphabetically.
+     * @param text The substring to look for.
+     * @param limit The maximum number of names to return.
+     */
+    SearchResult substringSearch(std::string_view text, size_t limit) const;
+
+   private:
+    /**
+     * @struct TrieNode
+     * @brief A trie node whose edge from the parent is labelled with a whole string.
+     */
+    struct TrieNode {
+        std::string label;               ///< Characters on the edge from the parent
+        std::vector<uint32_t> children;  ///< Sorted by the first character of their label
+        uint32_t count{0};               ///< Names ending in this subtree
+        bool terminal{false};            ///< True if a name ends exactly here
+    };
+
+    static constexpr size_t MIN_REBUILD_SLOTS = 1024;
+
+    std::vector<TrieNode> nodes{TrieNode{}};  ///< nodes[0] is the root
+    std::vector<uint32_t> freeNodes;
+
+    std::vector<std::string> slots;  ///< Slot -> name; empty once the name is erased
+    std::unordered_map<std::string, uint32_t> slotOf;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings;  ///< Trigram -> sorted slots
+    size_t deadSlots{0};
+
+    static uint32_t gramKey(std::string_view text, size_t pos);
+
+    size_t childPosition(uint32_t node, char first) const;
+    uint32_t findChild(uint32_t node, char first) const;
+    uint32_t newNode(std::string label);
+    void freeNode(uint32_t node);
+    void mergeWithOnlyChild(uint32_t node);
+    void trieInsert(std::string_view name);
+    bool trieErase(std::string_view name);
+
+    void indexGrams(uint32_t slot);
+    void rebuildGrams();
+};
@@ -0,0 +1,44 @@
+/**
+ * @file SnapshotConverter.cpp
+ * @brief Converts the employee database between the text and the binary snapshot formats.
+ *
+ * Usage:
+ *     employee_snapshot_convert to-binary employees.txt employees.bin
+ *     employee_snapshot_convert to-text employees.bin employees.txt
+ *
+ * employee_program prefers employees.bin over employees.txt when both exist.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BinarySnapshot.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " (to-binary | to-text) <input> <output>\n";
+        return 1;
+    }
+    std::string mode = argv[1];
+    std::string error;
+    bool ok = false;
+    if (mode == "to-binary") {
+        std::vector<std::string> skipped;
+        ok = BinarySnapshot::convertTextToBinary(argv[2], argv[3], skipped, error);
+        for (const auto& line : skipped) {
+            std::cerr << "Warning: Skipping invalid employee: " << line << "\n";
+        }
+    } else if (mode == "to-text") {
+        ok = BinarySnapshot::convertBinaryToText(argv[2], argv[3], error);
+    } else {
+        error = "unknown mode '" + mode + "'";
+    }
+
+    if (!ok) {
+        std::cerr << "Conversion failed: " << error << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << argv[3] << "\n";
+    return 0;
+}
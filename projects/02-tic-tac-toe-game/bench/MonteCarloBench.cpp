@@ -0,0 +1,66 @@
+/**
+ * @file MonteCarloBench.cpp
+ * @brief Measures how MonteCarloSearch playout throughput scales with threads.
+ *
+ * Usage: tic_tac_toe_mcts_bench [board size] [ms per run] [win length]   (default: 9, 2000, size)
+ *
+ * Searches the empty board (and a position after two moves) for a fixed time with 1, 2, 4, 8
+ * and one-per-hardware-thread workers, and reports playouts per second and the speedup over
+ * one thread.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "GameEngine.hpp"
+#include "MonteCarloSearch.hpp"
+
+int main(int argc, char* argv[]) {
+    int size = argc > 1 ? std::atoi(argv[1]) : 9;
+    int millis = argc > 2 ? std::atoi(argv[2]) : 2000;
+    int winLength = argc > 3 ? std::atoi(argv[3]) : size;
+    if (size < GameEngine::MIN_SIZE || size > GameEngine::MAX_SIZE || millis <= 0 ||
+        winLength < GameEngine::MIN_WIN_LENGTH || winLength > size) {
+        std::cerr << "Usage: tic_tac_toe_mcts_bench [board size 3-19] [ms per run] [win length]\n";
+        return 1;
+    }
+
+    int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> threadCounts{1, 2, 4, 8, hardware};
+    std::sort(threadCounts.begin(), threadCounts.end());
+    threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+
+    GameEngine empty(size, winLength);
+    GameEngine opened(size, winLength);
+    opened.move(opened.cellOf(size / 2, size / 2));
+    opened.move(opened.cellOf(0, 0));
+
+    std::cout << size << "x" << size << " board, " << winLength << " in a row, " << millis
+              << " ms per run, " << hardware << " hardware thread(s)\n\n"
+              << std::left << std::setw(10) << "position" << std::right << std::setw(8)
+              << "threads" << std::setw(14) << "playouts/s" << std::setw(10) << "speedup"
+              << std::setw(12) << "tree nodes" << std::setw(8) << "move" << "\n"
+              << std::fixed << std::setprecision(2);
+
+    for (const GameEngine* game : {&empty, &opened}) {
+        double baseline = 0;
+        for (int threads : threadCounts) {
+            MonteCarloSearch search(threads);
+            MonteCarloSearch::Result result =
+                search.search(*game, std::chrono::milliseconds(millis));
+            if (threads == 1) baseline = result.playoutsPerSecond();
+
+            std::cout << std::left << std::setw(10) << (game == &empty ? "empty" : "opened")
+                      << std::right << std::setw(8) << threads << std::setw(14)
+                      << static_cast<long long>(result.playoutsPerSecond()) << std::setw(9)
+                      << (baseline > 0 ? result.playoutsPerSecond() / baseline : 0.0) << "x"
+                      << std::setw(12) << result.treeNodes << std::setw(8) << result.move << "\n";
+        }
+    }
+    return 0;
+}
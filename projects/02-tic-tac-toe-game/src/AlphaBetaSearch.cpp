@@ -0,0 +1,185 @@
+#include "AlphaBetaSearch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+constexpr int INFINITE_SCORE = AlphaBetaSearch::WIN_SCORE + 1;
+constexpr int DECIDED_SCORE = AlphaBetaSearch::DECIDED_SCORE;
+
+/**
+ * @brief Stores decided scores relative to the cached position instead of the root.
+ */
+int toTable(int score, int ply) {
+    if (score > DECIDED_SCORE) return score + ply;
+    if (score < -DECIDED_SCORE) return score - ply;
+    return score;
+}
+
+int fromTable(int score, int ply) {
+    if (score > DECIDED_SCORE) return score - ply;
+    if (score < -DECIDED_SCORE) return score + ply;
+    return score;
+}
+}  // namespace
+
+AlphaBetaSearch::AlphaBetaSearch(size_t tableEntries)
+    : table(std::make_shared<TranspositionTable>(tableEntries)) {}
+
+AlphaBetaSearch::AlphaBetaSearch(std::shared_ptr<TranspositionTable> table)
+    : table(std::move(table)) {}
+
+void AlphaBetaSearch::clearTable() { table->clear(); }
+
+int AlphaBetaSearch::evaluate(const GameEngine& game) {
+    int side = game.sideToMove();
+    int score = 0;
+    for (int window = 0; window < game.windows(); ++window) {
+        int mine = game.stonesInWindow(side, window);
+        int theirs = game.stonesInWindow(side ^ 1, window);
+        if (theirs == 0 && mine > 0) {
+            score += 1 << std::min(mine, MAX_WEIGHT_SHIFT);
+        } else if (mine == 0 && theirs > 0) {
+            score -= 1 << std::min(theirs, MAX_WEIGHT_SHIFT);
+        }
+    }
+    // Long windows on big boards must never look like a decided game
+    return std::clamp(score, -DECIDED_SCORE + 1, DECIDED_SCORE - 1);
+}
+
+AlphaBetaSearch::Result AlphaBetaSearch::search(GameEngine& game, std::chrono::milliseconds budget,
+                                                int maxDepth) {
+    auto start = Clock::now();
+    deadline = start + budget;
+    nodes = 0;
+    aborted = false;
+    canAbort = false;
+    prepareMoveOrder(game);
+
+    Result result;
+    int emptyCells = game.cells() - game.moveCount();
+    for (int depth = 1; depth <= std::min(emptyCells, maxDepth); ++depth) {
+        int bestMove = result.move;
+        int score = searchRoot(game, depth, bestMove);
+        if (aborted) break;
+
+        result.move = bestMove;
+        result.score = score;
+        result.depth = depth;
+        result.solved = depth == emptyCells || std::abs(score) > DECIDED_SCORE;
+        if (result.solved) break;
+        canAbort = true;
+    }
+
+    result.nodes = nodes;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+int AlphaBetaSearch::searchRoot(GameEngine& game, int depth, int& bestMove) {
+    std::array<int, Bitboard::MAX_CELLS> moves;
+    int count = orderedMoves(game, bestMove, moves.data());
+
+    int alpha = -INFINITE_SCORE;
+    for (int i = 0; i < count; ++i) {
+        game.move(moves[i]);
+        int score = -negamax(game, depth - 1, -INFINITE_SCORE, -alpha, 1);
+        game.undo();
+        if (aborted) return alpha;
+        if (score > alpha) {
+            alpha = score;
+            bestMove = moves[i];
+        }
+    }
+    return alpha;
+}
+
+int AlphaBetaSearch::negamax(GameEngine& game, int depth, int alpha, int beta, int ply) {
+    ++nodes;
+    if (outOfTime()) return 0;
+    if (game.lastMoveWins()) return -(WIN_SCORE - ply);
+    if (game.viableLines() == 0) return 0;
+    if (depth == 0) return evaluate(game);
+
+    Entry entry;
+    int tableMove = -1;
+    if (table->probe(game.hash(), entry)) {
+        tableMove = entry.move;
+        if (entry.depth >= depth) {
+            int score = fromTable(entry.score, ply);
+            if (entry.bound == TranspositionTable::EXACT) return score;
+            if (entry.bound == TranspositionTable::LOWER) alpha = std::max(alpha, score);
+            if (entry.bound == TranspositionTable::UPPER) beta = std::min(beta, score);
+            if (alpha >= beta) return score;
+        }
+    }
+
+    std::array<int, Bitboard::MAX_CELLS> moves;
+    int count = orderedMoves(game, tableMove, moves.data());
+
+    int originalAlpha = alpha;
+    int best = -INFINITE_SCORE;
+    int bestMove = -1;
+    for (int i = 0; i < count; ++i) {
+        game.move(moves[i]);
+        int score = -negamax(game, depth - 1, -beta, -alpha, ply + 1);
+        game.undo();
+        if (aborted) return 0;
+        if (score > best) {
+            best = score;
+            bestMove = moves[i];
+        }
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) break;
+    }
+
+    entry.score = toTable(best, ply);
+    entry.depth = depth;
+    entry.bound = best <= originalAlpha ? TranspositionTable::UPPER
+                  : best >= beta        ? TranspositionTable::LOWER
+                                        : TranspositionTable::EXACT;
+    entry.move = bestMove;
+    table->store(game.hash(), entry);
+    return best;
+}
+
+void AlphaBetaSearch::prepareMoveOrder(const GameEngine& game) {
+    if (orderedSize == game.size() && orderedWinLength == game.winLength()) return;
+    orderedSize = game.size();
+    orderedWinLength = game.winLength();
+
+    // Cells on more windows first (the center, and the corners when k = N), then closer to
+    // the center
+    int n = game.size();
+    auto centerDistance = [n](int cell) {
+        return std::abs(2 * (cell / n) - (n - 1)) + std::abs(2 * (cell % n) - (n - 1));
+    };
+    moveOrder.resize(game.cells());
+    for (int cell = 0; cell < game.cells(); ++cell) moveOrder[cell] = cell;
+    std::stable_sort(moveOrder.begin(), moveOrder.end(), [&](int a, int b) {
+        if (game.windowsThrough(a) != game.windowsThrough(b)) {
+            return game.windowsThrough(a) > game.windowsThrough(b);
+        }
+        return centerDistance(a) < centerDistance(b);
+    });
+}
+
+int AlphaBetaSearch::orderedMoves(const GameEngine& game, int firstMove, int* out) const {
+    int count = 0;
+    if (firstMove >= 0 && firstMove < game.cells() && game.isEmpty(firstMove)) {
+        out[count++] = firstMove;
+    }
+    for (int cell : moveOrder) {
+        if (cell != firstMove && game.isEmpty(cell)) out[count++] = cell;
+    }
+    return count;
+}
+
+bool AlphaBetaSearch::outOfTime() {
+    if (canAbort && nodes % NODES_PER_CLOCK_CHECK == 0 && Clock::now() >= deadline) {
+        aborted = true;
+    }
+    return aborted;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file AlphaBetaSearch.hpp
+ * @brief Computer opponent: negamax alpha-beta search with a transposition table.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "GameEngine.hpp"
+#include "TranspositionTable.hpp"
+
+/**
+ * @class AlphaBetaSearch
+ * @brief Finds a move by iterative deepening under a time budget.
+ *
+ * Every iteration is a negamax alpha-beta search one ply deeper than the last. Positions are
+ * cached in a Zobrist-hashed transposition table that survives between iterations and moves,
+ * so each iteration starts from the best moves found so far. The table may be shared by
+ * searches running on several threads. Positions where no window is
+ * viable any more are scored as draws right away.
+ */
+class AlphaBetaSearch {
+   public:
+    static constexpr int WIN_SCORE = 1'000'000;  ///< Score of winning now; less for later wins
+    /// Scores beyond this bound are wins or losses a known number of plies away
+    static constexpr int DECIDED_SCORE = WIN_SCORE - Bitboard::MAX_CELLS;
+    static constexpr size_t DEFAULT_TABLE_ENTRIES = size_t{1} << 20;
+    static constexpr int UNLIMITED_DEPTH = std::numeric_limits<int>::max();
+
+    /**
+     * @struct Result
+     * @brief The chosen move and statistics of one search.
+     */
+    struct Result {
+        int move{-1};         ///< Cell to play
+        int score{0};         ///< From the side to move's point of view
+        int depth{0};         ///< Deepest fully searched iteration
+        bool solved{false};   ///< True if the score is exact (searched to the end of the game)
+        uint64_t nodes{0};    ///< Positions visited
+        double seconds{0.0};  ///< Wall time
+
+        double nodesPerSecond() const { return seconds > 0 ? nodes / seconds : 0.0; }
+    };
+
+    /**
+     * @param tableEntries Transposition table size, rounded up to a power of two.
+     */
+    explicit AlphaBetaSearch(size_t tableEntries = DEFAULT_TABLE_ENTRIES);
+
+    /**
+     * @param table A transposition table, possibly shared with searches on other threads.
+     */
+    explicit AlphaBetaSearch(std::shared_ptr<TranspositionTable> table);
+
+    /**
+     * @brief Searches the position for the side to move. The game must still be playing.
+     * @param game The position; it is modified during the search and restored afterwards.
+     * @param budget Time budget. The first iteration always completes.
+     * @param maxDepth Stops deepening after this many plies.
+     */
+    Result search(GameEngine& game, std::chrono::milliseconds budget,
+                  int maxDepth = UNLIMITED_DEPTH);
+
+    /**
+     * @brief Scores a position statically, from the side to move's point of view.
+     *
+     * Each viable window is worth 2^s to the player with s stones on it.
+     */
+    static int evaluate(const GameEngine& game);
+
+    /**
+     * @brief Forgets every cached position.
+     */
+    void clearTable();
+
+   private:
+    using Clock = std::chrono::steady_clock;
+    using Entry = TranspositionTable::Entry;
+
+    static constexpr uint64_t NODES_PER_CLOCK_CHECK = 1024;
+    static constexpr int MAX_WEIGHT_SHIFT = 12;
+
+    std::shared_ptr<TranspositionTable> table;
+    std::vector<int> moveOrder;  ///< Cells, most windows through them first
+    int orderedSize{0};
+    int orderedWinLength{0};
+
+    uint64_t nodes{0};
+    Clock::time_point deadline;
+    bool canAbort{false};
+    bool aborted{false};
+
+    int negamax(GameEngine& game, int depth, int alpha, int beta, int ply);
+    int searchRoot(GameEngine& game, int depth, int& bestMove);
+    void prepareMoveOrder(const GameEngine& game);
+    int orderedMoves(const GameEngine& game, int firstMove, int* out) const;
+    bool outOfTime();
+};
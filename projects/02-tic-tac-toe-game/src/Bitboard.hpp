@@ -0,0 +1,85 @@
+/**
+ * @file Bitboard.hpp
+ * @brief Fixed-size bit set with one bit per board cell.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @struct Bitboard
+ * @brief One bit per cell of the largest supported board, cell i being bit (i % 64) of word
+ * (i / 64).
+ *
+ * Every operation touches a fixed number of words, so all of them are constant time.
+ */
+struct Bitboard {
+    static constexpr int MAX_CELLS = 361;  ///< A 19x19 board
+    static constexpr int WORDS = (MAX_CELLS + 63) / 64;
+
+    std::array<uint64_t, WORDS> words{};
+
+    void set(int cell) { words[cell >> 6] |= uint64_t{1} << (cell & 63); }
+    void reset(int cell) { words[cell >> 6] &= ~(uint64_t{1} << (cell & 63)); }
+    bool test(int cell) const { return (words[cell >> 6] >> (cell & 63)) & 1; }
+
+    /**
+     * @brief Number of set bits.
+     */
+    int count() const {
+        int total = 0;
+        for (uint64_t word : words) total += popcount(word);
+        return total;
+    }
+
+    /**
+     * @brief True if any bit is set in both bitboards.
+     */
+    bool intersects(const Bitboard& other) const {
+        uint64_t common = 0;
+        for (int i = 0; i < WORDS; ++i) common |= words[i] & other.words[i];
+        return common != 0;
+    }
+
+    /**
+     * @brief True if every bit of `mask` is set here.
+     */
+    bool contains(const Bitboard& mask) const {
+        uint64_t missing = 0;
+        for (int i = 0; i < WORDS; ++i) missing |= mask.words[i] & ~words[i];
+        return missing == 0;
+    }
+
+    Bitboard operator&(const Bitboard& other) const {
+        Bitboard result;
+        for (int i = 0; i < WORDS; ++i) result.words[i] = words[i] & other.words[i];
+        return result;
+    }
+
+    Bitboard operator|(const Bitboard& other) const {
+        Bitboard result;
+        for (int i = 0; i < WORDS; ++i) result.words[i] = words[i] | other.words[i];
+        return result;
+    }
+
+    bool operator==(const Bitboard& other) const { return words == other.words; }
+    bool operator!=(const Bitboard& other) const { return words != other.words; }
+
+    static int popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<int>(__popcnt64(word));
+#else
+        int total = 0;
+        for (; word; word &= word - 1) ++total;
+        return total;
+#endif
+    }
+};
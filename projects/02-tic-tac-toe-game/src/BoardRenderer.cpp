@@ -0,0 +1,108 @@
+#include "BoardRenderer.hpp"
+
+#include <cstring>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+BoardRenderer::BoardRenderer(Mode mode, std::string path)
+    : renderMode(mode), filePath(std::move(path)) {
+    if (filePath.empty()) filePath = mode == Mode::MoveLog ? LOG_FILE : BOARD_FILE;
+}
+
+void BoardRenderer::release() {
+#if !defined(_WIN32)
+    if (mapping) munmap(mapping, mappingSize);
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    if (stream.is_open()) stream.close();
+}
+
+std::string BoardRenderer::render(const GameEngine& game) {
+    std::string text = "\n";
+    text += FRAME;
+    for (int row = 0; row < game.size(); ++row) {
+        for (int col = 0; col < game.size(); ++col) {
+            int player = game.playerAt(game.cellOf(row, col));
+            text += player == GameEngine::NO_PLAYER ? '.' : GameEngine::symbol(player);
+            text += ' ';
+        }
+        text += '\n';
+    }
+    text += FRAME;
+    return text;
+}
+
+size_t BoardRenderer::cellOffset(int cell) const {
+    size_t row = cell / gridSize;
+    size_t col = cell % gridSize;
+    return 1 + std::strlen(FRAME) + row * (2 * gridSize + 1) + 2 * col;
+}
+
+void BoardRenderer::start(const GameEngine& game) {
+    release();
+    gridSize = game.size();
+    if (renderMode == Mode::Rewrite) {
+        std::ofstream(filePath) << render(game);
+        return;
+    }
+    if (renderMode == Mode::MoveLog) {
+        stream.open(filePath, std::ios::app);
+        stream << "# new game " << gridSize << "x" << gridSize << ", " << game.winLength()
+               << " in a row" << std::endl;
+        return;
+    }
+
+    std::string text = render(game);
+#if !defined(_WIN32)
+    int fd = ::open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        if (ftruncate(fd, static_cast<off_t>(text.size())) == 0) {
+            void* address = mmap(nullptr, text.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (address != MAP_FAILED) {
+                mapping = static_cast<char*>(address);
+                mappingSize = text.size();
+                std::memcpy(mapping, text.data(), text.size());
+            }
+        }
+        ::close(fd);
+        if (mapping) return;
+    }
+#endif
+    // No mmap: write the file once, then patch single bytes through a seekable stream
+    stream.open(filePath, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+    stream << text << std::flush;
+}
+
+void BoardRenderer::update(const GameEngine& game) {
+    int cell = game.lastMove();
+    if (cell < 0) return;
+    char symbol = GameEngine::symbol(game.playerAt(cell));
+
+    if (renderMode == Mode::Rewrite) {
+        std::ofstream(filePath) << render(game);
+    } else if (renderMode == Mode::MoveLog) {
+        stream << game.moveCount() << ' ' << symbol << ' ' << cell / gridSize + 1 << ' '
+               << cell % gridSize + 1 << std::endl;
+    } else if (mapping) {
+        mapping[cellOffset(cell)] = symbol;
+    } else if (stream.is_open()) {
+        stream.seekp(static_cast<std::streamoff>(cellOffset(cell)));
+        stream.put(symbol).flush();
+    }
+}
+
+void BoardRenderer::finish(const GameEngine& game) {
+    if (renderMode != Mode::MoveLog) return;
+    GameEngine::Status status = game.status();
+    if (status == GameEngine::Status::Won) {
+        stream << "# " << GameEngine::symbol(game.sideToMove() ^ 1) << " won" << std::endl;
+    } else if (status == GameEngine::Status::Draw) {
+        stream << "# tie" << std::endl;
+    }
+}
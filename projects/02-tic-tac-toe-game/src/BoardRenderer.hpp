@@ -0,0 +1,83 @@
+/**
+ * @file BoardRenderer.hpp
+ * @brief Writes the board for external viewers: a rewritten file, a memory-mapped file
+ * patched in place, or an append-only move log.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#include "GameEngine.hpp"
+
+/**
+ * @class BoardRenderer
+ * @brief Keeps board.txt (or moves.log) in step with a game.
+ *
+ * The board file always has the same layout, so the byte of every cell sits at a fixed offset:
+ *
+ *     \n<============================>\n
+ *     one line per row: the cell symbols ('.', 'x', 'o'), each followed by a space
+ *     <============================>\n
+ *
+ * - Rewrite truncates and writes the whole file after every move (O(N^2) bytes per move).
+ * - InPlace sizes the file once, maps it shared and writable, and stores only the byte of the
+ *   played cell (O(1) per move). Readers of the file see the change without any write call.
+ *   Platforms without mmap seek to the cell and write the byte instead.
+ * - MoveLog appends one line per move, `<ply> <symbol> <row> <col>` (1-based), to a log
+ *   that viewers can tail; the start and the end of each game are `#` comment lines.
+ */
+class BoardRenderer {
+   public:
+    enum class Mode { Rewrite, InPlace, MoveLog };
+
+    static constexpr const char* BOARD_FILE = "board.txt";
+    static constexpr const char* LOG_FILE = "moves.log";
+
+    /**
+     * @param mode How to publish the board.
+     * @param path The board file, or the log in MoveLog mode; empty means the default name.
+     */
+    explicit BoardRenderer(Mode mode = Mode::Rewrite, std::string path = "");
+
+    BoardRenderer(const BoardRenderer&) = delete;
+    BoardRenderer& operator=(const BoardRenderer&) = delete;
+
+    ~BoardRenderer() { release(); }
+
+    /**
+     * @brief Publishes the whole position; called once at the start of a game.
+     *
+     * If the file cannot be written, the game goes on without it, as with the plain rewrite.
+     */
+    void start(const GameEngine& game);
+
+    /**
+     * @brief Publishes the last move of `game`.
+     */
+    void update(const GameEngine& game);
+
+    /**
+     * @brief Records the end of the game (MoveLog mode only).
+     */
+    void finish(const GameEngine& game);
+
+    Mode mode() const { return renderMode; }
+    const std::string& path() const { return filePath; }
+
+   private:
+    static constexpr const char* FRAME = "<============================>\n";
+
+    Mode renderMode;
+    std::string filePath;
+    std::ofstream stream;  ///< The move log, or the board file when it cannot be mapped
+    char* mapping{nullptr};
+    size_t mappingSize{0};
+    int gridSize{0};
+
+    void release();
+    static std::string render(const GameEngine& game);
+    size_t cellOffset(int cell) const;
+};
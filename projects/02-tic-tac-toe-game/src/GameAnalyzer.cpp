@@ -0,0 +1,142 @@
+#include "GameAnalyzer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief +1 for a known win, -1 for a known loss, 0 otherwise.
+ */
+int outcomeClass(int score) {
+    if (score > AlphaBetaSearch::DECIDED_SCORE) return 1;
+    if (score < -AlphaBetaSearch::DECIDED_SCORE) return -1;
+    return 0;
+}
+
+/**
+ * @brief Turns the score of the position after a move into the score of the move itself.
+ */
+int scoreOfMove(int childScore) {
+    int score = -childScore;
+    // A win or loss seen from the child is one ply further away from the parent
+    if (score > AlphaBetaSearch::DECIDED_SCORE) return score - 1;
+    if (score < -AlphaBetaSearch::DECIDED_SCORE) return score + 1;
+    return score;
+}
+
+LoggedGame::Result resultOf(const GameEngine& game) {
+    GameEngine::Status status = game.status();
+    if (status == GameEngine::Status::Won) {
+        return game.sideToMove() == GameEngine::O ? LoggedGame::Result::XWon
+                                                  : LoggedGame::Result::OWon;
+    }
+    if (status == GameEngine::Status::Draw) return LoggedGame::Result::Draw;
+    return LoggedGame::Result::Abandoned;
+}
+}  // namespace
+
+std::vector<GameAnalysis> analyzeGames(const std::vector<LoggedGame>& games,
+                                       const AnalysisConfig& config, AnalysisSummary& summary) {
+    std::vector<GameAnalysis> analyses(games.size());
+    auto table = std::make_shared<TranspositionTable>(config.tableEntries);
+    int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    summary = AnalysisSummary{};
+    summary.threads = config.threads > 0 ? config.threads : hardware;
+    summary.lengths.assign(Bitboard::MAX_CELLS + 1, 0);
+    std::atomic<size_t> nextGame{0};
+    std::mutex summaryMutex;
+
+    auto worker = [&]() {
+        AlphaBetaSearch search(table);
+        std::optional<GameEngine> engine;
+        AnalysisSummary local;
+        local.lengths.assign(Bitboard::MAX_CELLS + 1, 0);
+
+        for (size_t i; (i = nextGame.fetch_add(1, std::memory_order_relaxed)) < games.size();) {
+            const LoggedGame& logged = games[i];
+            GameAnalysis& analysis = analyses[i];
+            if (!engine || engine->size() != logged.size ||
+                engine->winLength() != logged.winLength) {
+                engine.emplace(logged.size, logged.winLength);
+            }
+            GameEngine& game = *engine;
+
+            for (int move : logged.moves) {
+                if (game.status() != GameEngine::Status::Playing) {
+                    analysis.error = "move after the end of the game";
+                    break;
+                }
+                if (move >= game.cells() || !game.isEmpty(move)) {
+                    analysis.error = "illegal move on cell " + std::to_string(move);
+                    break;
+                }
+                int mover = game.sideToMove();
+                AlphaBetaSearch::Result best = search.search(game, config.budget, config.maxDepth);
+                local.nodes += best.nodes;
+
+                MoveAnnotation annotation;
+                annotation.move = move;
+                annotation.bestMove = best.move;
+                annotation.bestScore = best.score;
+                game.move(move);
+                if (game.lastMoveWins()) {
+                    annotation.playedScore = AlphaBetaSearch::WIN_SCORE - 1;
+                } else if (game.status() == GameEngine::Status::Playing) {
+                    AlphaBetaSearch::Result reply =
+                        search.search(game, config.budget, config.maxDepth);
+                    local.nodes += reply.nodes;
+                    annotation.playedScore = scoreOfMove(reply.score);
+                }
+                annotation.agrees = move == best.move || annotation.playedScore >= best.score;
+                annotation.blunder =
+                    outcomeClass(annotation.playedScore) < outcomeClass(annotation.bestScore);
+                analysis.moves.push_back(annotation);
+
+                ++local.moves;
+                ++local.playerMoves[mover];
+                local.agreements[mover] += annotation.agrees;
+                local.blunders[mover] += annotation.blunder;
+            }
+            if (analysis.error.empty() && logged.result != LoggedGame::Result::Abandoned &&
+                logged.result != resultOf(game)) {
+                analysis.error = "the logged result does not match the moves";
+            }
+
+            ++local.games;
+            if (analysis.error.empty()) {
+                ++local.results[static_cast<size_t>(logged.result)];
+                ++local.lengths[game.moveCount()];
+            } else {
+                ++local.invalidGames;
+            }
+            while (game.moveCount() > 0) game.undo();
+        }
+
+        std::lock_guard<std::mutex> lock(summaryMutex);
+        summary.games += local.games;
+        summary.invalidGames += local.invalidGames;
+        summary.moves += local.moves;
+        summary.nodes += local.nodes;
+        for (int player : {GameEngine::X, GameEngine::O}) {
+            summary.blunders[player] += local.blunders[player];
+            summary.agreements[player] += local.agreements[player];
+            summary.playerMoves[player] += local.playerMoves[player];
+        }
+        for (size_t r = 0; r < summary.results.size(); ++r) summary.results[r] += local.results[r];
+        for (size_t n = 0; n < summary.lengths.size(); ++n) summary.lengths[n] += local.lengths[n];
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 1; t < summary.threads; ++t) workers.emplace_back(worker);
+    worker();
+    for (auto& thread : workers) thread.join();
+    summary.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return analyses;
+}
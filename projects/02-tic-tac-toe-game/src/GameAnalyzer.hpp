@@ -0,0 +1,80 @@
+/**
+ * @file GameAnalyzer.hpp
+ * @brief Replays archived games in parallel and annotates every move with a search result.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AlphaBetaSearch.hpp"
+#include "MoveLog.hpp"
+
+/**
+ * @struct MoveAnnotation
+ * @brief The engine's view of one played move, scores from the mover's point of view.
+ */
+struct MoveAnnotation {
+    int move{-1};
+    int bestMove{-1};
+    int bestScore{0};    ///< Of the best move
+    int playedScore{0};  ///< Of the played move
+    bool agrees{false};  ///< The played move is the best one, or scores as well
+    bool blunder{false};  ///< It throws away a win, or turns a draw into a loss
+};
+
+/**
+ * @struct GameAnalysis
+ * @brief Annotations of one game, or why it could not be replayed.
+ */
+struct GameAnalysis {
+    std::vector<MoveAnnotation> moves;
+    std::string error;  ///< Empty if the game replayed cleanly
+};
+
+/**
+ * @struct AnalysisConfig
+ * @brief Search limits per position and the parallelism of the analysis.
+ */
+struct AnalysisConfig {
+    int maxDepth{AlphaBetaSearch::UNLIMITED_DEPTH};
+    std::chrono::milliseconds budget{100};  ///< Per position searched
+    int threads{0};                         ///< 0 means one per hardware thread
+    size_t tableEntries{size_t{1} << 22};   ///< Of the transposition table shared by all
+};
+
+/**
+ * @struct AnalysisSummary
+ * @brief Totals over every analyzed game.
+ */
+struct AnalysisSummary {
+    uint64_t games{0};
+    uint64_t invalidGames{0};
+    uint64_t moves{0};
+    std::array<uint64_t, 2> blunders{};    ///< By player
+    std::array<uint64_t, 2> agreements{};  ///< By player
+    std::array<uint64_t, 2> playerMoves{};
+    std::array<uint64_t, 4> results{};  ///< By LoggedGame::Result
+    std::vector<uint64_t> lengths;     ///< Games by number of moves
+    uint64_t nodes{0};
+    int threads{0};
+    double seconds{0.0};
+};
+
+/**
+ * @brief Analyzes games on worker threads that share one lock-free transposition table.
+ *
+ * Each move costs two searches: the position before it (the best move and its score) and the
+ * position after it (the score of the played move). Positions reached in several games, such
+ * as common openings, are found in the shared table instead of being searched again.
+ * @param games The archive.
+ * @param config Search limits and thread count.
+ * @param summary Receives the totals.
+ * @return The analysis of each game, in archive order.
+ */
+std::vector<GameAnalysis> analyzeGames(const std::vector<LoggedGame>& games,
+                                       const AnalysisConfig& config, AnalysisSummary& summary);
@@ -0,0 +1,108 @@
+#include "GameEngine.hpp"
+
+#include <cassert>
+
+namespace {
+/**
+ * @brief SplitMix64: a small, well-mixed generator, enough to fill the Zobrist table.
+ */
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+}  // namespace
+
+GameEngine::GameEngine(int size, int winLength) : gridSize(size), k(winLength ? winLength : size) {
+    assert(size >= MIN_SIZE && size <= MAX_SIZE);
+    assert(k >= MIN_WIN_LENGTH && k <= size);
+    moves.reserve(cells());
+
+    // Enumerate the windows in the 4 directions, counting them per cell first (CSR layout)
+    std::vector<std::vector<int>> windowsOf(cells());
+    int count = 0;
+    for (int d = 0; d < 4; ++d) {
+        for (int r = 0; r < gridSize; ++r) {
+            for (int c = 0; c < gridSize; ++c) {
+                int endRow = r + (k - 1) * dr[d];
+                int endCol = c + (k - 1) * dc[d];
+                if (endRow < 0 || endRow >= gridSize || endCol < 0 || endCol >= gridSize) continue;
+                for (int i = 0; i < k; ++i) {
+                    windowsOf[cellOf(r + i * dr[d], c + i * dc[d])].push_back(count);
+                }
+                ++count;
+            }
+        }
+    }
+    windowStart.assign(1, 0);
+    for (const auto& list : windowsOf) {
+        cellWindows.insert(cellWindows.end(), list.begin(), list.end());
+        windowStart.push_back(static_cast<int>(cellWindows.size()));
+    }
+    stonesOn[X].assign(count, 0);
+    stonesOn[O].assign(count, 0);
+    viable = count;
+
+    // Games with other rules must not share hashes with this one
+    uint64_t state = static_cast<uint64_t>(gridSize) << 8 | static_cast<uint64_t>(k);
+    zobristHash = splitMix64(state);
+}
+
+uint64_t GameEngine::zobristKey(int player, int cell) {
+    static const auto keys = [] {
+        std::array<std::array<uint64_t, Bitboard::MAX_CELLS>, 2> table{};
+        uint64_t state = 0x5EF17AC70E;
+        for (auto& row : table) {
+            for (auto& key : row) key = splitMix64(state);
+        }
+        return table;
+    }();
+    return keys[player][cell];
+}
+
+int GameEngine::playerAt(int cell) const {
+    if (players[X].test(cell)) return X;
+    if (players[O].test(cell)) return O;
+    return NO_PLAYER;
+}
+
+void GameEngine::move(int cell) {
+    int player = sideToMove();
+    std::vector<uint8_t>& own = stonesOn[player];
+    const std::vector<uint8_t>& opponent = stonesOn[player ^ 1];
+    bool won = false;
+    for (int i = windowStart[cell]; i < windowStart[cell + 1]; ++i) {
+        int window = cellWindows[i];
+        // The window dies when the first stone of the second player lands on it
+        if (own[window] == 0 && opponent[window] > 0) --viable;
+        won |= ++own[window] == k;
+    }
+    players[player].set(cell);
+    moves.push_back(cell);
+    zobristHash ^= zobristKey(player, cell);
+    lastWon = won;
+}
+
+void GameEngine::undo() {
+    int cell = moves.back();
+    moves.pop_back();
+    int player = sideToMove();
+    players[player].reset(cell);
+    zobristHash ^= zobristKey(player, cell);
+
+    std::vector<uint8_t>& own = stonesOn[player];
+    const std::vector<uint8_t>& opponent = stonesOn[player ^ 1];
+    for (int i = windowStart[cell]; i < windowStart[cell + 1]; ++i) {
+        int window = cellWindows[i];
+        if (--own[window] == 0 && opponent[window] > 0) ++viable;
+    }
+    // Nobody moves after a win, so the position before the undone move was still playing
+    lastWon = false;
+}
+
+GameEngine::Status GameEngine::status() const {
+    if (lastWon) return Status::Won;
+    if (viable == 0) return Status::Draw;
+    return Status::Playing;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file GameEngine.hpp
+ * @brief Bitboard game state of an N x N k-in-a-row game (TicTacToe when k = N).
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Bitboard.hpp"
+
+/**
+ * @class GameEngine
+ * @brief Board state, move history and win/draw detection, with no input or output.
+ *
+ * Each player's stones are a Bitboard. A window is a run of k consecutive cells in one of the
+ * 4 directions (for k = N: the rows, columns and two diagonals). Every cell knows the windows
+ * through it, and every window counts the stones of each player on it. A move only updates the
+ * (at most 4k) windows around the played cell, so move(), undo() and the win check cost O(k)
+ * whatever the board size: a player wins when one of those windows reaches k stones.
+ *
+ * A window stays viable while at most one player has stones on it; once no window is viable
+ * the game is a draw, possibly long before the board is full.
+ *
+ * The position also carries a Zobrist hash, updated by move() and undo(), for transposition
+ * tables. The side to move follows from the stone count, so it needs no key of its own; the
+ * empty board hashes from the size and k, so one table can hold games of different rules.
+ */
+class GameEngine {
+   public:
+    static constexpr int MIN_SIZE = 3;
+    static constexpr int MAX_SIZE = 19;
+    static constexpr int MIN_WIN_LENGTH = 3;
+    static constexpr int NO_PLAYER = -1;
+    static constexpr int X = 0;
+    static constexpr int O = 1;
+
+    enum class Status { Playing, Won, Draw };
+
+    /**
+     * @brief Creates an empty board.
+     * @param size Board side, between MIN_SIZE and MAX_SIZE.
+     * @param winLength Stones in a row needed to win, between MIN_WIN_LENGTH and size;
+     * 0 means size (classic TicTacToe).
+     */
+    explicit GameEngine(int size, int winLength = 0);
+
+    int size() const { return gridSize; }
+    int winLength() const { return k; }
+    int cells() const { return gridSize * gridSize; }
+    int cellOf(int row, int col) const { return row * gridSize + col; }
+
+    /**
+     * @brief The player to move: X on even plies, O on odd ones.
+     */
+    int sideToMove() const { return static_cast<int>(moves.size() & 1); }
+
+    int moveCount() const { return static_cast<int>(moves.size()); }
+    const std::vector<int>& history() const { return moves; }
+
+    /**
+     * @brief The cell of the last move, or -1 before the first move.
+     */
+    int lastMove() const { return moves.empty() ? -1 : moves.back(); }
+
+    const Bitboard& stones(int player) const { return players[player]; }
+    Bitboard occupied() const { return players[X] | players[O]; }
+    bool isEmpty(int cell) const { return !players[X].test(cell) && !players[O].test(cell); }
+
+    /**
+     * @brief The player owning a cell, or NO_PLAYER if it is empty.
+     */
+    int playerAt(int cell) const;
+
+    /**
+     * @brief Number of windows that still hold stones of at most one player.
+     */
+    int viableLines() const { return viable; }
+
+    int windows() const { return static_cast<int>(stonesOn[X].size()); }
+
+    /**
+     * @brief Stones of `player` on a window.
+     */
+    int stonesInWindow(int player, int window) const { return stonesOn[player][window]; }
+
+    /**
+     * @brief Number of windows through a cell.
+     */
+    int windowsThrough(int cell) const { return windowStart[cell + 1] - windowStart[cell]; }
+
+    /**
+     * @brief The `index`-th window through a cell, for index < windowsThrough(cell).
+     */
+    int windowThrough(int cell, int index) const { return cellWindows[windowStart[cell] + index]; }
+
+    uint64_t hash() const { return zobristHash; }
+
+    /**
+     * @brief Places a stone of the side to move on an empty cell.
+     */
+    void move(int cell);
+
+    /**
+     * @brief Takes back the last move.
+     */
+    void undo();
+
+    /**
+     * @brief True if the last move completed k in a row.
+     */
+    bool lastMoveWins() const { return lastWon; }
+
+    /**
+     * @brief Won if the last move completed k in a row, Draw if no window is viable, else
+     * Playing.
+     */
+    Status status() const;
+
+    static char symbol(int player) { return player == X ? 'x' : 'o'; }
+
+   private:
+    // anti-diag (down-left), col (down), main-diag (down-right), row (right)
+    static constexpr int dr[4]{1, 1, 1, 0};
+    static constexpr int dc[4]{-1, 0, 1, 1};
+
+    int gridSize;
+    int k;
+    std::array<Bitboard, 2> players{};
+    std::vector<int> moves;
+    int viable{0};
+    bool lastWon{false};
+    uint64_t zobristHash{0};
+
+    std::array<std::vector<uint8_t>, 2> stonesOn;  ///< Per player, stones on each window
+    std::vector<int> windowStart;  ///< Windows of cell c: cellWindows[windowStart[c]...]
+    std::vector<int> cellWindows;
+
+    /**
+     * @brief The random key of a stone of `player` on `cell`.
+     */
+    static uint64_t zobristKey(int player, int cell);
+};
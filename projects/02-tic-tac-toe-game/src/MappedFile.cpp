@@ -0,0 +1,47 @@
+#include "MappedFile.hpp"
+
+#include <fstream>
+#include <iterator>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+void MappedFile::release() {
+#if !defined(_WIN32)
+    if (mapped) munmap(const_cast<char*>(bytes), length);
+#endif
+    buffer.clear();
+    bytes = nullptr;
+    length = 0;
+    mapped = false;
+}
+
+bool MappedFile::open(const std::string& path) {
+    release();
+#if !defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            bytes = static_cast<const char*>(address);
+            length = info.st_size;
+            mapped = true;
+        }
+    }
+    ::close(fd);
+    if (mapped) return true;
+#endif
+    // Empty files cannot be mapped, and non-POSIX platforms fall back to a plain read
+    std::ifstream file(path, std::ios::binary);
+    if (file.fail()) return false;
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+    return true;
+}
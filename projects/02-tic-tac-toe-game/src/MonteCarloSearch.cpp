@@ -0,0 +1,189 @@
+#include "MonteCarloSearch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+/**
+ * @brief xorshift64*: a fast per-thread generator for random playouts.
+ */
+uint64_t nextRandom(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief A random index below `count`.
+ */
+int randomBelow(uint64_t& state, int count) {
+    return static_cast<int>(((nextRandom(state) >> 32) * static_cast<uint64_t>(count)) >> 32);
+}
+}  // namespace
+
+MonteCarloSearch::MonteCarloSearch(int threads, size_t poolNodes)
+    : threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      capacity(poolNodes),
+      pool(new Node[poolNodes]) {}
+
+MonteCarloSearch::Result MonteCarloSearch::search(const GameEngine& game,
+                                                  std::chrono::milliseconds budget,
+                                                  uint64_t maxPlayouts) {
+    auto start = Clock::now();
+    used = 1;
+    playouts = 0;
+    resetNode(pool[0], -1);
+    expand(pool[0], game);
+
+    uint64_t seed = static_cast<uint64_t>(start.time_since_epoch().count()) | 1;
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) {
+        workers.emplace_back(&MonteCarloSearch::worker, this, game,
+                             seed + t * 0x9E3779B97F4A7C15ULL, start + budget, maxPlayouts);
+    }
+    worker(game, seed, start + budget, maxPlayouts);
+    for (auto& thread : workers) thread.join();
+
+    Result result;
+    const Node& root = pool[0];
+    int32_t first = root.firstChild.load(std::memory_order_acquire);
+    int32_t bestVisits = -1;
+    for (int32_t i = first; first >= 0 && i < first + root.childCount; ++i) {
+        int32_t visits = pool[i].visits.load(std::memory_order_relaxed);
+        if (visits > bestVisits) {
+            bestVisits = visits;
+            result.move = pool[i].move;
+            result.winRate = visits ? pool[i].score.load() / (2.0 * visits) : 0.0;
+        }
+    }
+    result.playouts = std::min(playouts.load(), maxPlayouts);
+    result.treeNodes = std::min(used.load(), capacity);
+    result.threads = threads;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+void MonteCarloSearch::worker(GameEngine game, uint64_t seed, Clock::time_point deadline,
+                              uint64_t maxPlayouts) {
+    uint64_t rng = seed;
+    const int rootPlayer = game.sideToMove();
+    std::vector<int32_t> path;
+    path.reserve(game.cells() + 1);
+
+    for (uint64_t done = 0;; ++done) {
+        if (done % 64 == 0 && Clock::now() >= deadline) break;
+        if (playouts.fetch_add(1, std::memory_order_relaxed) >= maxPlayouts) break;
+
+        // Selection and expansion, with a virtual loss on every node on the way down
+        path.assign(1, 0);
+        pool[0].visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+        int movesPlayed = 0;
+        int winner = GameEngine::NO_PLAYER;
+        while (true) {
+            GameEngine::Status status = game.status();
+            if (status != GameEngine::Status::Playing) {
+                winner = status == GameEngine::Status::Won ? game.sideToMove() ^ 1
+                                                           : GameEngine::NO_PLAYER;
+                break;
+            }
+            Node& node = pool[path.back()];
+            int32_t first = node.firstChild.load(std::memory_order_acquire);
+            if (first == UNEXPANDED &&
+                node.visits.load(std::memory_order_relaxed) >= VIRTUAL_LOSS + EXPAND_AFTER_VISITS &&
+                expand(node, game)) {
+                first = node.firstChild.load(std::memory_order_acquire);
+            }
+            if (first < 0) {
+                winner = rollout(game, rng, movesPlayed);
+                break;
+            }
+            int32_t child = selectChild(node, first);
+            pool[child].visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+            game.move(pool[child].move);
+            ++movesPlayed;
+            path.push_back(child);
+        }
+
+        // Backpropagation: path[i] was entered by a move of the root player for odd i
+        for (size_t i = 0; i < path.size(); ++i) {
+            int mover = i % 2 == 1 ? rootPlayer : rootPlayer ^ 1;
+            int32_t reward = winner == GameEngine::NO_PLAYER ? 1 : winner == mover ? 2 : 0;
+            Node& node = pool[path[i]];
+            node.score.fetch_add(reward, std::memory_order_relaxed);
+            node.visits.fetch_add(1 - VIRTUAL_LOSS, std::memory_order_relaxed);
+        }
+        while (movesPlayed-- > 0) game.undo();
+    }
+}
+
+void MonteCarloSearch::resetNode(Node& node, int move) {
+    node.visits.store(0, std::memory_order_relaxed);
+    node.score.store(0, std::memory_order_relaxed);
+    node.firstChild.store(UNEXPANDED, std::memory_order_relaxed);
+    node.childCount = 0;
+    node.move = static_cast<int16_t>(move);
+}
+
+bool MonteCarloSearch::expand(Node& node, const GameEngine& game) {
+    int count = game.cells() - game.moveCount();
+    if (used.load(std::memory_order_relaxed) + count > capacity) return false;
+
+    int32_t expected = UNEXPANDED;
+    if (!node.firstChild.compare_exchange_strong(expected, EXPANDING,
+                                                 std::memory_order_acq_rel)) {
+        return false;
+    }
+    size_t first = used.fetch_add(count, std::memory_order_relaxed);
+    if (first + count > capacity) {
+        node.firstChild.store(UNEXPANDED, std::memory_order_release);
+        return false;
+    }
+
+    size_t next = first;
+    for (int cell = 0; cell < game.cells(); ++cell) {
+        if (game.isEmpty(cell)) resetNode(pool[next++], cell);
+    }
+    node.childCount = static_cast<int16_t>(count);
+    node.firstChild.store(static_cast<int32_t>(first), std::memory_order_release);
+    return true;
+}
+
+int32_t MonteCarloSearch::selectChild(const Node& node, int32_t firstChild) const {
+    double logVisits = std::log(std::max(1, node.visits.load(std::memory_order_relaxed)));
+    int32_t best = firstChild;
+    double bestValue = -1.0;
+    for (int32_t i = firstChild; i < firstChild + node.childCount; ++i) {
+        int32_t visits = pool[i].visits.load(std::memory_order_relaxed);
+        if (visits <= 0) return i;
+        double value = pool[i].score.load(std::memory_order_relaxed) / (2.0 * visits) +
+                       EXPLORATION * std::sqrt(logVisits / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+int MonteCarloSearch::rollout(GameEngine& game, uint64_t& rng, int& movesPlayed) {
+    std::array<int, Bitboard::MAX_CELLS> empty;
+    int count = 0;
+    for (int cell = 0; cell < game.cells(); ++cell) {
+        if (game.isEmpty(cell)) empty[count++] = cell;
+    }
+
+    while (true) {
+        GameEngine::Status status = game.status();
+        if (status == GameEngine::Status::Won) return game.sideToMove() ^ 1;
+        if (status == GameEngine::Status::Draw || count == 0) return GameEngine::NO_PLAYER;
+
+        int pick = randomBelow(rng, count);
+        game.move(empty[pick]);
+        empty[pick] = empty[--count];
+        ++movesPlayed;
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file MonteCarloSearch.hpp
+ * @brief Computer opponent for large boards: multithreaded Monte Carlo Tree Search.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "GameEngine.hpp"
+
+/**
+ * @class MonteCarloSearch
+ * @brief UCT search with tree parallelism: all threads grow one shared tree.
+ *
+ * Node statistics are atomics, so selection and backpropagation take no locks. A thread
+ * walking down the tree adds a virtual loss to every node it passes, which steers the other
+ * threads towards different branches until its playout result is backed up. Nodes come from
+ * a fixed pool; leaves are expanded by whichever thread claims them first with a
+ * compare-and-swap, and once the pool is full the tree simply stops growing.
+ */
+class MonteCarloSearch {
+   public:
+    static constexpr size_t DEFAULT_POOL_NODES = size_t{1} << 21;
+    static constexpr uint64_t UNLIMITED = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * @struct Result
+     * @brief The chosen move and statistics of one search.
+     */
+    struct Result {
+        int move{-1};          ///< Most visited move at the root
+        double winRate{0.0};   ///< Of that move for the side to move, draws counting half
+        uint64_t playouts{0};
+        size_t treeNodes{0};
+        int threads{0};
+        double seconds{0.0};
+
+        double playoutsPerSecond() const { return seconds > 0 ? playouts / seconds : 0.0; }
+    };
+
+    /**
+     * @param threads Worker threads per search; 0 means one per hardware thread.
+     * @param poolNodes Capacity of the node pool.
+     */
+    explicit MonteCarloSearch(int threads = 0, size_t poolNodes = DEFAULT_POOL_NODES);
+
+    /**
+     * @brief Searches the position for the side to move. The game must still be playing.
+     * @param game The position; it is not modified.
+     * @param budget Time budget.
+     * @param maxPlayouts Stops earlier once this many playouts are done.
+     */
+    Result search(const GameEngine& game, std::chrono::milliseconds budget,
+                  uint64_t maxPlayouts = UNLIMITED);
+
+    int threadCount() const { return threads; }
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int32_t UNEXPANDED = -1;
+    static constexpr int32_t EXPANDING = -2;
+    static constexpr int32_t VIRTUAL_LOSS = 3;
+    static constexpr int32_t EXPAND_AFTER_VISITS = 8;
+    static constexpr double EXPLORATION = 1.41421356;
+
+    /**
+     * @struct Node
+     * @brief One position in the tree, reached by `move`.
+     *
+     * `score` counts 2 per win and 1 per draw for the player who made `move`. `childCount` is
+     * written before `firstChild` is published with release semantics.
+     */
+    struct Node {
+        std::atomic<int32_t> visits{0};
+        std::atomic<int32_t> score{0};
+        std::atomic<int32_t> firstChild{UNEXPANDED};
+        int16_t childCount{0};
+        int16_t move{-1};
+    };
+
+    int threads;
+    size_t capacity;
+    std::unique_ptr<Node[]> pool;
+    std::atomic<size_t> used{0};
+    std::atomic<uint64_t> playouts{0};
+
+    void worker(GameEngine game, uint64_t seed, Clock::time_point deadline, uint64_t maxPlayouts);
+    void resetNode(Node& node, int move);
+    bool expand(Node& node, const GameEngine& game);
+    int32_t selectChild(const Node& node, int32_t firstChild) const;
+    static int rollout(GameEngine& game, uint64_t& rng, int& movesPlayed);
+};
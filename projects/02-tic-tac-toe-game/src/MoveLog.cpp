@@ -0,0 +1,160 @@
+#include "MoveLog.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+#include "MappedFile.hpp"
+
+namespace {
+constexpr char MAGIC[8] = {'T', 'T', 'T', 'M', 'O', 'V', 'E', 'S'};
+
+/**
+ * @brief Decodes one LEB128 varint; false if it runs past the end or overflows.
+ */
+bool readVarint(const unsigned char*& cursor, const unsigned char* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        if (cursor == end) return false;
+        unsigned char byte = *cursor++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Parses a whole log in memory.
+ * @param games Receives the complete games; may be null to only validate.
+ * @param validEnd Receives the offset just past the last complete game.
+ */
+bool parseLog(const char* data, size_t size, std::vector<LoggedGame>* games, std::string& error,
+              size_t& validEnd) {
+    if (size < sizeof(MAGIC) || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "not a move log";
+        return false;
+    }
+
+    auto* begin = reinterpret_cast<const unsigned char*>(data);
+    auto* cursor = begin + sizeof(MAGIC);
+    auto* end = begin + size;
+    auto corrupt = [&](const char* what, const unsigned char* gameStart) {
+        error = std::string("bad ") + what + " in the game at byte " +
+                std::to_string(gameStart - begin);
+        return false;
+    };
+    validEnd = sizeof(MAGIC);
+    while (cursor != end) {
+        const unsigned char* gameStart = cursor;
+        if (end - cursor < 2) break;  // cut off in its header
+        LoggedGame game;
+        game.size = *cursor++;
+        game.winLength = *cursor++;
+        if (game.size < GameEngine::MIN_SIZE || game.size > GameEngine::MAX_SIZE ||
+            game.winLength < GameEngine::MIN_WIN_LENGTH || game.winLength > game.size) {
+            return corrupt("header", gameStart);
+        }
+
+        uint32_t value = 0;
+        bool complete = false;
+        while (readVarint(cursor, end, value)) {
+            if (value == 0) {
+                complete = cursor != end;
+                break;
+            }
+            if (value > static_cast<uint32_t>(game.size * game.size)) {
+                return corrupt("move", gameStart);
+            }
+            game.moves.push_back(static_cast<int>(value) - 1);
+        }
+        // Only the last game can be incomplete: it was still being played, or crashed
+        if (!complete) {
+            if (cursor != end) return corrupt("move", gameStart);
+            break;
+        }
+        uint8_t result = *cursor++;
+        if (result > static_cast<uint8_t>(LoggedGame::Result::Abandoned)) {
+            return corrupt("result", gameStart);
+        }
+        game.result = static_cast<LoggedGame::Result>(result);
+        validEnd = cursor - begin;
+        if (games) games->push_back(std::move(game));
+    }
+    return true;
+}
+}  // namespace
+
+bool MoveLogWriter::open(const std::string& path) {
+    file.close();
+    inGame = false;
+    bool isNew = true;
+    size_t validEnd = 0;
+    size_t size = 0;
+    {
+        MappedFile existing;
+        isNew = !existing.open(path) || existing.size() == 0;
+        size = existing.size();
+        std::string error;
+        if (!isNew && !parseLog(existing.data(), size, nullptr, error, validEnd)) return false;
+    }
+    // Drop a game cut short by a crash, or the next game would be read as its moves
+    if (!isNew && validEnd < size) {
+        std::error_code failed;
+        std::filesystem::resize_file(path, validEnd, failed);
+        if (failed) return false;
+    }
+    file.open(path, std::ios::binary | std::ios::app);
+    if (!file) return false;
+    if (isNew) file.write(MAGIC, sizeof(MAGIC)).flush();
+    return true;
+}
+
+void MoveLogWriter::writeVarint(uint32_t value) {
+    while (value >= 0x80) {
+        file.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    file.put(static_cast<char>(value));
+}
+
+void MoveLogWriter::startGame(const GameEngine& game) {
+    if (!isOpen()) return;
+    if (inGame) finishGame(game);
+    file.put(static_cast<char>(game.size())).put(static_cast<char>(game.winLength())).flush();
+    inGame = true;
+}
+
+void MoveLogWriter::recordMove(const GameEngine& game) {
+    if (!isOpen() || !inGame || game.lastMove() < 0) return;
+    writeVarint(static_cast<uint32_t>(game.lastMove()) + 1);
+    file.flush();
+}
+
+void MoveLogWriter::finishGame(const GameEngine& game) {
+    if (!isOpen() || !inGame) return;
+    auto result = LoggedGame::Result::Abandoned;
+    GameEngine::Status status = game.status();
+    if (status == GameEngine::Status::Won) {
+        result = game.sideToMove() == GameEngine::O ? LoggedGame::Result::XWon
+                                                    : LoggedGame::Result::OWon;
+    } else if (status == GameEngine::Status::Draw) {
+        result = LoggedGame::Result::Draw;
+    }
+    writeVarint(0);
+    file.put(static_cast<char>(result)).flush();
+    inGame = false;
+}
+
+bool readMoveLog(const std::string& path, std::vector<LoggedGame>& games, std::string& error) {
+    MappedFile log;
+    if (!log.open(path)) {
+        error = "cannot open " + path;
+        return false;
+    }
+    size_t validEnd = 0;
+    if (!parseLog(log.data(), log.size(), &games, error, validEnd)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
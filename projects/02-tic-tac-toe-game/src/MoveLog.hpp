@@ -0,0 +1,83 @@
+/**
+ * @file MoveLog.hpp
+ * @brief Compact binary archive of played games, appended to move by move.
+ *
+ * File layout:
+ *
+ *     "TTTMOVES"                     8-byte magic, written once when the file is created
+ *     games, back to back:
+ *         uint8 size, uint8 winLength
+ *         varint (cell + 1)          one per move, 1 byte on boards up to 11x11
+ *         varint 0                   end of the moves
+ *         uint8 result               0: x won, 1: o won, 2: draw, 3: abandoned
+ *
+ * Varints are LEB128: 7 bits per byte, high bit set on every byte but the last. A classic
+ * 3x3 game takes at most 13 bytes. Every move is flushed as it is played, so a game cut short
+ * by a crash is simply missing its end marker and is skipped on reading.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GameEngine.hpp"
+
+/**
+ * @struct LoggedGame
+ * @brief One archived game.
+ */
+struct LoggedGame {
+    enum class Result : uint8_t { XWon, OWon, Draw, Abandoned };
+
+    int size{3};
+    int winLength{3};
+    std::vector<int> moves;
+    Result result{Result::Abandoned};
+};
+
+/**
+ * @class MoveLogWriter
+ * @brief Appends games to a move log.
+ */
+class MoveLogWriter {
+   public:
+    static constexpr const char* DEFAULT_FILE = "games.bin";
+
+    /**
+     * @brief Opens (or creates) the log for appending.
+     * @return False if the file cannot be opened or is not a move log.
+     */
+    bool open(const std::string& path = DEFAULT_FILE);
+
+    bool isOpen() const { return file.is_open(); }
+
+    void startGame(const GameEngine& game);
+
+    /**
+     * @brief Appends the last move of `game`.
+     */
+    void recordMove(const GameEngine& game);
+
+    /**
+     * @brief Closes the current game with its result (Abandoned if it is still playing).
+     */
+    void finishGame(const GameEngine& game);
+
+   private:
+    std::ofstream file;
+    bool inGame{false};
+
+    void writeVarint(uint32_t value);
+};
+
+/**
+ * @brief Reads every complete game of a move log (O(file size)).
+ * @param path The log file.
+ * @param games Receives the games, in file order.
+ * @param error Receives the reason on failure.
+ * @return False if the file cannot be read, is not a move log, or is corrupt.
+ */
+bool readMoveLog(const std::string& path, std::vector<LoggedGame>& games, std::string& error);
@@ -0,0 +1,154 @@
+#include "Policy.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+/**
+ * @brief xorshift64*: cheap randomness for move choices and tie breaks.
+ */
+uint64_t nextRandom(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+int randomBelow(uint64_t& state, int count) {
+    return static_cast<int>(((nextRandom(state) >> 32) * static_cast<uint64_t>(count)) >> 32);
+}
+
+constexpr int64_t WIN_NOW = int64_t{1} << 62;
+constexpr int64_t BLOCK_LOSS = int64_t{1} << 61;
+constexpr int MAX_WEIGHT_SHIFT = 24;
+
+/**
+ * @brief How good a move on `cell` is for `side`, judged by the windows through it.
+ */
+int64_t scoreCell(const GameEngine& game, int side, int cell) {
+    int k = game.winLength();
+    int64_t score = 0;
+    for (int i = 0; i < game.windowsThrough(cell); ++i) {
+        int window = game.windowThrough(cell, i);
+        int mine = game.stonesInWindow(side, window);
+        int theirs = game.stonesInWindow(side ^ 1, window);
+        if (theirs == 0) {
+            if (mine == k - 1) return WIN_NOW;
+            score += int64_t{1} << std::min(2 * mine + 1, MAX_WEIGHT_SHIFT);
+        }
+        if (mine == 0) {
+            if (theirs == k - 1) score |= BLOCK_LOSS;
+            score += int64_t{1} << std::min(2 * theirs, MAX_WEIGHT_SHIFT);
+        }
+    }
+    return score;
+}
+}  // namespace
+
+RandomPolicy::RandomPolicy(uint64_t seed) : rng(seed | 1) {}
+
+int RandomPolicy::chooseMove(GameEngine& game) {
+    int pick = randomBelow(rng, game.cells() - game.moveCount());
+    for (int cell = 0;; ++cell) {
+        if (game.isEmpty(cell) && pick-- == 0) return cell;
+    }
+}
+
+GreedyPolicy::GreedyPolicy(uint64_t seed) : rng(seed | 1) {}
+
+int GreedyPolicy::chooseMove(GameEngine& game) {
+    int side = game.sideToMove();
+    int64_t best = -1;
+    int bestMove = -1;
+    int ties = 0;
+    for (int cell = 0; cell < game.cells(); ++cell) {
+        if (!game.isEmpty(cell)) continue;
+        int64_t score = scoreCell(game, side, cell);
+        if (score > best) {
+            best = score;
+            bestMove = cell;
+            ties = 1;
+        } else if (score == best && randomBelow(rng, ++ties) == 0) {
+            // Reservoir sampling keeps every tied cell equally likely
+            bestMove = cell;
+        }
+    }
+    return bestMove;
+}
+
+AlphaBetaPolicy::AlphaBetaPolicy(std::chrono::milliseconds budget, size_t tableEntries)
+    : search(tableEntries), budget(budget) {}
+
+int AlphaBetaPolicy::chooseMove(GameEngine& game) { return search.search(game, budget).move; }
+
+MonteCarloPolicy::MonteCarloPolicy(uint64_t playouts)
+    // Enough for one search on most boards; a full pool only stops the tree from growing, so
+    // large budgets stop at the interactive game's pool size instead of scaling memory
+    : search(1, static_cast<size_t>(std::min<uint64_t>(playouts * 64 + Bitboard::MAX_CELLS + 1,
+                                                       MonteCarloSearch::DEFAULT_POOL_NODES))),
+      playouts(playouts) {}
+
+int MonteCarloPolicy::chooseMove(GameEngine& game) {
+    // The playout limit ends the search, the time budget is only a safety net
+    return search.search(game, std::chrono::hours(1), playouts).move;
+}
+
+PolicySpec PolicySpec::parse(const std::string& text) {
+    size_t colon = text.find(':');
+    std::string kind = text.substr(0, colon);
+    PolicySpec spec;
+    if (kind == "random") {
+        spec.kind = Kind::Random;
+    } else if (kind == "greedy") {
+        spec.kind = Kind::Greedy;
+    } else if (kind == "alphabeta") {
+        spec.kind = Kind::AlphaBeta;
+        spec.budget = 10;
+    } else if (kind == "mcts") {
+        spec.kind = Kind::MonteCarlo;
+        spec.budget = 1000;
+    } else {
+        throw std::invalid_argument("unknown policy '" + kind + "'");
+    }
+
+    if (colon != std::string::npos) {
+        std::string budget = text.substr(colon + 1);
+        bool digits = !budget.empty() && budget.size() <= 9 &&
+                      std::all_of(budget.begin(), budget.end(), [](char c) {
+                          return c >= '0' && c <= '9';
+                      });
+        if (!digits || spec.budget == 0 || std::stoull(budget) == 0) {
+            throw std::invalid_argument("bad budget in '" + text + "'");
+        }
+        spec.budget = std::stoull(budget);
+    }
+    return spec;
+}
+
+std::string PolicySpec::toString() const {
+    switch (kind) {
+        case Kind::Random:
+            return "random";
+        case Kind::Greedy:
+            return "greedy";
+        case Kind::AlphaBeta:
+            return "alphabeta:" + std::to_string(budget) + "ms";
+        case Kind::MonteCarlo:
+            return "mcts:" + std::to_string(budget);
+    }
+    return "";
+}
+
+std::unique_ptr<Policy> PolicySpec::create(uint64_t seed) const {
+    switch (kind) {
+        case Kind::Random:
+            return std::make_unique<RandomPolicy>(seed);
+        case Kind::Greedy:
+            return std::make_unique<GreedyPolicy>(seed);
+        case Kind::AlphaBeta:
+            return std::make_unique<AlphaBetaPolicy>(std::chrono::milliseconds(budget));
+        case Kind::MonteCarlo:
+            return std::make_unique<MonteCarloPolicy>(budget);
+    }
+    return nullptr;
+}
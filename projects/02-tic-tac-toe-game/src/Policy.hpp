@@ -0,0 +1,131 @@
+/**
+ * @file Policy.hpp
+ * @brief Headless move choosers for self-play: random, greedy, alpha-beta and Monte Carlo.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "AlphaBetaSearch.hpp"
+#include "GameEngine.hpp"
+#include "MonteCarloSearch.hpp"
+
+/**
+ * @class Policy
+ * @brief Picks a move for the side to move, without any input or output.
+ *
+ * A policy may keep state between moves and games (a transposition table, a random
+ * generator), so one instance must only be used by one thread at a time.
+ */
+class Policy {
+   public:
+    virtual ~Policy() = default;
+
+    /**
+     * @brief Chooses an empty cell. The game must still be playing.
+     * @param game The position; it may be modified during the call but is restored afterwards.
+     */
+    virtual int chooseMove(GameEngine& game) = 0;
+
+    virtual std::string name() const = 0;
+};
+
+/**
+ * @class RandomPolicy
+ * @brief Plays a uniformly random empty cell.
+ */
+class RandomPolicy : public Policy {
+   public:
+    explicit RandomPolicy(uint64_t seed);
+    int chooseMove(GameEngine& game) override;
+    std::string name() const override { return "random"; }
+
+   private:
+    uint64_t rng;
+};
+
+/**
+ * @class GreedyPolicy
+ * @brief One-ply heuristic: wins now if it can, otherwise blocks an immediate loss, otherwise
+ * plays the cell with the best open windows.
+ *
+ * A cell is scored from the window counters through it in O(k), so a move costs O(N^2 k).
+ * Ties are broken at random.
+ */
+class GreedyPolicy : public Policy {
+   public:
+    explicit GreedyPolicy(uint64_t seed);
+    int chooseMove(GameEngine& game) override;
+    std::string name() const override { return "greedy"; }
+
+   private:
+    uint64_t rng;
+};
+
+/**
+ * @class AlphaBetaPolicy
+ * @brief Plays the move of an AlphaBetaSearch under a fixed time budget.
+ */
+class AlphaBetaPolicy : public Policy {
+   public:
+    /**
+     * @param budget Time per move.
+     * @param tableEntries Transposition table size; kept small so many policies fit in memory.
+     */
+    explicit AlphaBetaPolicy(std::chrono::milliseconds budget, size_t tableEntries = 1 << 16);
+    int chooseMove(GameEngine& game) override;
+    std::string name() const override { return "alphabeta"; }
+
+   private:
+    AlphaBetaSearch search;
+    std::chrono::milliseconds budget;
+};
+
+/**
+ * @class MonteCarloPolicy
+ * @brief Plays the move of a single-threaded MonteCarloSearch with a fixed playout count.
+ *
+ * Self-play already runs one game per thread, so each search stays on the calling thread.
+ */
+class MonteCarloPolicy : public Policy {
+   public:
+    explicit MonteCarloPolicy(uint64_t playouts);
+    int chooseMove(GameEngine& game) override;
+    std::string name() const override { return "mcts"; }
+
+   private:
+    MonteCarloSearch search;
+    uint64_t playouts;
+};
+
+/**
+ * @struct PolicySpec
+ * @brief Describes a policy so that every worker thread can build its own instance.
+ *
+ * Written as `kind[:budget]`: `random`, `greedy`, `alphabeta[:ms per move]` (default 10) or
+ * `mcts[:playouts per move]` (default 1000).
+ */
+struct PolicySpec {
+    enum class Kind { Random, Greedy, AlphaBeta, MonteCarlo };
+
+    Kind kind{Kind::Random};
+    uint64_t budget{0};
+
+    /**
+     * @brief Parses `kind[:budget]`.
+     * @throws std::invalid_argument on an unknown kind or a bad budget.
+     */
+    static PolicySpec parse(const std::string& text);
+
+    std::string toString() const;
+
+    /**
+     * @brief Builds a fresh policy.
+     * @param seed Seeds the random generator of the random and greedy policies.
+     */
+    std::unique_ptr<Policy> create(uint64_t seed) const;
+};
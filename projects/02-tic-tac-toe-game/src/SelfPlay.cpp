@@ -0,0 +1,133 @@
+#include "SelfPlay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Games a worker takes from the shared counter at a time.
+ */
+constexpr uint64_t BATCH_GAMES = 64;
+}  // namespace
+
+void LatencyHistogram::record(uint64_t nanos) {
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && (nanos >> (bucket + 1)) != 0) ++bucket;
+    ++buckets[bucket];
+    ++count;
+    totalNanos += nanos;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKETS; ++i) buckets[i] += other.buckets[i];
+    count += other.count;
+    totalNanos += other.totalNanos;
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    if (count == 0) return 0;
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * count + 0.5));
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return uint64_t{1} << (i + 1);
+    }
+    return uint64_t{1} << BUCKETS;
+}
+
+GameRecord playGame(GameEngine& game, Policy& x, Policy& o,
+                    std::array<LatencyHistogram, 2>* latency) {
+    std::array<Policy*, 2> players{&x, &o};
+    GameEngine::Status status = GameEngine::Status::Playing;
+    while (status == GameEngine::Status::Playing) {
+        int side = game.sideToMove();
+        if (latency) {
+            auto start = Clock::now();
+            int move = players[side]->chooseMove(game);
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            (*latency)[side].record(static_cast<uint64_t>(nanos.count()));
+            game.move(move);
+        } else {
+            game.move(players[side]->chooseMove(game));
+        }
+        status = game.status();
+    }
+
+    GameRecord record;
+    record.moves = game.moveCount();
+    if (status == GameEngine::Status::Won) record.winner = game.sideToMove() ^ 1;
+    while (game.moveCount() > 0) game.undo();
+    return record;
+}
+
+TournamentResult runTournament(const TournamentConfig& config) {
+    TournamentResult total;
+    int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    total.threads = config.threads > 0 ? config.threads : hardware;
+    std::atomic<uint64_t> nextGame{0};
+    std::mutex totalMutex;
+    uint64_t seed = static_cast<uint64_t>(Clock::now().time_since_epoch().count());
+
+    auto worker = [&](int index) {
+        uint64_t threadSeed = seed + static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15ULL;
+        std::unique_ptr<Policy> first = config.first.create(threadSeed);
+        std::unique_ptr<Policy> second = config.second.create(~threadSeed);
+        GameEngine game(config.size, config.winLength);
+
+        TournamentResult local;
+        // Latencies by player, separately for the games where `first` plays x and o
+        std::array<std::array<LatencyHistogram, 2>, 2> bySide;
+        for (;;) {
+            uint64_t begin = nextGame.fetch_add(BATCH_GAMES, std::memory_order_relaxed);
+            if (begin >= config.games) break;
+            uint64_t end = std::min(begin + BATCH_GAMES, config.games);
+            for (uint64_t i = begin; i < end; ++i) {
+                bool firstIsX = !config.alternateColors || i % 2 == 0;
+                GameRecord record = firstIsX ? playGame(game, *first, *second, &bySide[0])
+                                             : playGame(game, *second, *first, &bySide[1]);
+                ++local.games;
+                local.moves += record.moves;
+                ++local.lengths[record.moves];
+                if (record.winner == GameEngine::NO_PLAYER) {
+                    ++local.draws;
+                } else {
+                    ++(record.winner == GameEngine::X ? local.xWins : local.oWins);
+                    ++((record.winner == GameEngine::X) == firstIsX ? local.firstWins
+                                                                    : local.secondWins);
+                }
+            }
+        }
+
+        local.latency[0].merge(bySide[0][GameEngine::X]);
+        local.latency[0].merge(bySide[1][GameEngine::O]);
+        local.latency[1].merge(bySide[0][GameEngine::O]);
+        local.latency[1].merge(bySide[1][GameEngine::X]);
+
+        std::lock_guard<std::mutex> lock(totalMutex);
+        total.games += local.games;
+        total.firstWins += local.firstWins;
+        total.secondWins += local.secondWins;
+        total.draws += local.draws;
+        total.xWins += local.xWins;
+        total.oWins += local.oWins;
+        total.moves += local.moves;
+        for (size_t i = 0; i < total.lengths.size(); ++i) total.lengths[i] += local.lengths[i];
+        total.latency[0].merge(local.latency[0]);
+        total.latency[1].merge(local.latency[1]);
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 1; t < total.threads; ++t) workers.emplace_back(worker, t);
+    worker(0);
+    for (auto& thread : workers) thread.join();
+    total.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return total;
+}
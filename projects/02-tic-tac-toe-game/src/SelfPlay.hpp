@@ -0,0 +1,101 @@
+/**
+ * @file SelfPlay.hpp
+ * @brief Headless games between two policies, and multithreaded tournaments of them.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "GameEngine.hpp"
+#include "Policy.hpp"
+
+/**
+ * @struct LatencyHistogram
+ * @brief Move latencies in power-of-two nanosecond buckets: bucket b holds [2^b, 2^(b+1)) ns.
+ *
+ * Recording is an increment, and histograms of different threads are merged by adding
+ * buckets, so percentiles are exact to within a factor of two.
+ */
+struct LatencyHistogram {
+    static constexpr int BUCKETS = 40;  ///< Up to about 18 minutes
+
+    std::array<uint64_t, BUCKETS> buckets{};
+    uint64_t count{0};
+    uint64_t totalNanos{0};
+
+    void record(uint64_t nanos);
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Upper bound of the bucket holding the given fraction of samples, in ns.
+     * @param fraction Between 0 and 1, e.g. 0.99.
+     */
+    uint64_t percentile(double fraction) const;
+
+    double meanNanos() const { return count ? static_cast<double>(totalNanos) / count : 0.0; }
+};
+
+/**
+ * @struct GameRecord
+ * @brief Outcome of one headless game.
+ */
+struct GameRecord {
+    int winner{GameEngine::NO_PLAYER};  ///< GameEngine::X, GameEngine::O or NO_PLAYER for a draw
+    int moves{0};
+};
+
+/**
+ * @brief Plays one game from the empty board to its end, with no input or output.
+ * @param game The board; it is reset by undoing every move afterwards.
+ * @param x The policy playing x.
+ * @param o The policy playing o.
+ * @param latency Receives the time of every move, indexed by player; may be null.
+ */
+GameRecord playGame(GameEngine& game, Policy& x, Policy& o,
+                    std::array<LatencyHistogram, 2>* latency = nullptr);
+
+/**
+ * @struct TournamentConfig
+ * @brief What to play: the board, the two policies and the number of games.
+ */
+struct TournamentConfig {
+    int size{3};
+    int winLength{0};  ///< 0 means size
+    PolicySpec first;
+    PolicySpec second;
+    uint64_t games{1000};
+    int threads{0};              ///< 0 means one per hardware thread
+    bool alternateColors{true};  ///< If false, `first` always plays x
+};
+
+/**
+ * @struct TournamentResult
+ * @brief Totals of a tournament, from the point of view of `first` and `second`.
+ */
+struct TournamentResult {
+    uint64_t games{0};
+    uint64_t firstWins{0};
+    uint64_t secondWins{0};
+    uint64_t draws{0};
+    uint64_t xWins{0};
+    uint64_t oWins{0};
+    uint64_t moves{0};
+    std::array<uint64_t, Bitboard::MAX_CELLS + 1> lengths{};  ///< Games by number of moves
+    std::array<LatencyHistogram, 2> latency;                  ///< Of `first` and `second`
+    int threads{0};
+    double seconds{0.0};
+
+    double gamesPerSecond() const { return seconds > 0 ? games / seconds : 0.0; }
+    double movesPerSecond() const { return seconds > 0 ? moves / seconds : 0.0; }
+};
+
+/**
+ * @brief Plays `config.games` games on worker threads and sums up the results.
+ *
+ * Every thread builds its own policies and board and takes games from a shared atomic counter
+ * in batches, so the threads only synchronize to fetch work and to merge their totals at the
+ * end. With alternateColors, `first` plays x in even games and o in odd ones.
+ */
+TournamentResult runTournament(const TournamentConfig& config);
@@ -0,0 +1,214 @@
+#include "Tablebase.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace {
+using Outcome = Tablebase::Outcome;
+using Value = Tablebase::Value;
+
+/**
+ * @brief Orders values for the side choosing between them: fast wins, then draws, then slow
+ * losses.
+ */
+int preference(const Value& value) {
+    switch (value.outcome) {
+        case Outcome::Win:
+            return 2000 - value.distance;
+        case Outcome::Draw:
+            return 1000 - value.distance;
+        default:
+            return value.distance;
+    }
+}
+
+/**
+ * @brief Tries every move of a position that is still being played and keeps the best one.
+ * @param valueOf Returns the value of a position that is still being played, for its side to
+ * move.
+ */
+template <typename ValueOf>
+Tablebase::Hint bestChild(GameEngine& game, ValueOf valueOf) {
+    Tablebase::Hint best;
+    for (int cell = 0; cell < game.cells(); ++cell) {
+        if (!game.isEmpty(cell)) continue;
+        game.move(cell);
+        Value value;
+        GameEngine::Status status = game.status();
+        if (status == GameEngine::Status::Won) {
+            value = {Outcome::Win, 1};
+        } else if (status == GameEngine::Status::Draw) {
+            value = {Outcome::Draw, 1};
+        } else {
+            Value reply = valueOf(game);
+            value.outcome = reply.outcome == Outcome::Win    ? Outcome::Loss
+                            : reply.outcome == Outcome::Loss ? Outcome::Win
+                                                             : Outcome::Draw;
+            value.distance = reply.distance + 1;
+        }
+        game.undo();
+        if (best.move < 0 || preference(value) > preference(best.value)) best = {cell, value};
+    }
+    return best;
+}
+}  // namespace
+
+std::string Tablebase::fileName(int boardSize) {
+    return "tablebase" + std::to_string(boardSize) + ".bin";
+}
+
+bool Tablebase::open(const std::string& path, std::string& error) {
+    slots = nullptr;
+    if (!file.open(path)) {
+        error = "cannot open " + path;
+        return false;
+    }
+    Header header;
+    if (file.size() < sizeof(Header)) {
+        error = "file too small for a tablebase header";
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "not a tablebase file";
+        return false;
+    }
+    if (header.version != VERSION) {
+        error = "unsupported tablebase version " + std::to_string(header.version);
+        return false;
+    }
+    if (header.boardSize < GameEngine::MIN_SIZE || header.boardSize > MAX_SIZE ||
+        header.slotCount == 0 || (header.slotCount & (header.slotCount - 1)) != 0 ||
+        file.size() != sizeof(Header) + header.slotCount * sizeof(uint32_t)) {
+        error = "corrupt tablebase header";
+        return false;
+    }
+
+    slots = reinterpret_cast<const uint32_t*>(file.data() + sizeof(Header));
+    slotCount = header.slotCount;
+    entries = header.entries;
+    size = static_cast<int>(header.boardSize);
+    symmetries = makeSymmetries(size);
+    return true;
+}
+
+std::optional<Tablebase::Value> Tablebase::probe(const GameEngine& game) const {
+    if (!isOpen() || game.size() != size || game.winLength() != size) return std::nullopt;
+    uint32_t key = canonicalKey(game, symmetries);
+    // At most one pass over the table: a damaged file may have no empty slot to stop at
+    uint64_t i = slotOf(key, slotCount);
+    for (uint64_t probes = 0; probes < slotCount; ++probes, i = (i + 1) & (slotCount - 1)) {
+        if (slots[i] == EMPTY_SLOT) return std::nullopt;
+        if ((slots[i] & KEY_MASK) == key) return unpack(slots[i]);
+    }
+    return std::nullopt;
+}
+
+std::optional<Tablebase::Hint> Tablebase::bestMove(GameEngine& game) const {
+    if (!probe(game)) return std::nullopt;
+    return bestChild(game,
+                     [this](const GameEngine& child) { return probe(child).value_or(Value{}); });
+}
+
+bool Tablebase::generate(int boardSize, const std::string& path, size_t& positions,
+                         std::string& error) {
+    if (boardSize < GameEngine::MIN_SIZE || boardSize > MAX_SIZE) {
+        error = "tablebases exist for boards of 3 to " + std::to_string(MAX_SIZE) + " only";
+        return false;
+    }
+
+    // Depth-first search over the reachable positions, memoized by canonical key
+    Symmetries symmetries = makeSymmetries(boardSize);
+    std::unordered_map<uint32_t, Value> solved;
+    GameEngine game(boardSize);
+    auto solve = [&](auto& self, GameEngine& position) -> Value {
+        uint32_t key = canonicalKey(position, symmetries);
+        auto it = solved.find(key);
+        if (it != solved.end()) return it->second;
+        Value value =
+            bestChild(position, [&](GameEngine& child) { return self(self, child); }).value;
+        solved.emplace(key, value);
+        return value;
+    };
+    solve(solve, game);
+
+    uint64_t slotCount = 1;
+    while (slotCount < 2 * solved.size()) slotCount <<= 1;
+    std::vector<uint32_t> table(slotCount, EMPTY_SLOT);
+    for (const auto& [key, value] : solved) {
+        uint64_t i = slotOf(key, slotCount);
+        while (table[i] != EMPTY_SLOT) i = (i + 1) & (slotCount - 1);
+        table[i] = pack(key, value);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.boardSize = static_cast<uint32_t>(boardSize);
+    header.entries = solved.size();
+    header.slotCount = slotCount;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(uint32_t));
+    if (!out) {
+        error = "cannot write " + path;
+        return false;
+    }
+    positions = solved.size();
+    return true;
+}
+
+Tablebase::Symmetries Tablebase::makeSymmetries(int boardSize) {
+    int n = boardSize;
+    Symmetries result;
+    for (int t = 0; t < 8; ++t) {
+        result[t].resize(n * n);
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                // Rotate by t % 4 quarter turns, then mirror if t >= 4
+                int row = r, col = c;
+                for (int turn = 0; turn < t % 4; ++turn) {
+                    int rotated = col;
+                    col = n - 1 - row;
+                    row = rotated;
+                }
+                if (t >= 4) col = n - 1 - col;
+                result[t][r * n + c] = row * n + col;
+            }
+        }
+    }
+    return result;
+}
+
+uint32_t Tablebase::canonicalKey(const GameEngine& game, const Symmetries& symmetries) {
+    std::array<uint32_t, MAX_SIZE * MAX_SIZE> digit{};
+    for (int cell = 0; cell < game.cells(); ++cell) {
+        digit[cell] = static_cast<uint32_t>(game.playerAt(cell) + 1);  // empty 0, x 1, o 2
+    }
+    uint32_t best = EMPTY_SLOT;
+    for (const auto& permutation : symmetries) {
+        uint32_t key = 0;
+        for (int cell = game.cells() - 1; cell >= 0; --cell) {
+            key = key * 3 + digit[permutation[cell]];
+        }
+        best = std::min(best, key);
+    }
+    return best;
+}
+
+uint64_t Tablebase::slotOf(uint32_t key, uint64_t slotCount) {
+    return (key * 0x9E3779B97F4A7C15ULL >> 20) & (slotCount - 1);
+}
+
+uint32_t Tablebase::pack(uint32_t key, const Value& value) {
+    return key | static_cast<uint32_t>(value.outcome) << KEY_BITS |
+           static_cast<uint32_t>(value.distance - 1) << (KEY_BITS + 2);
+}
+
+Tablebase::Value Tablebase::unpack(uint32_t slot) {
+    return {static_cast<Outcome>(slot >> KEY_BITS & 3),
+            static_cast<int>(slot >> (KEY_BITS + 2)) + 1};
+}
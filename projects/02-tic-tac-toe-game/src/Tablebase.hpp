@@ -0,0 +1,123 @@
+/**
+ * @file Tablebase.hpp
+ * @brief Solved game values of every reachable 3x3 or 4x4 position, loadable with mmap.
+ *
+ * File layout (native byte order):
+ *
+ *     Header                 32 bytes
+ *     uint32_t[slotCount]    open-addressing hash table, EMPTY_SLOT where unused
+ *
+ * Each slot packs a canonical position key (bits 0-25: the cells in base 3, after picking
+ * the smallest of the 8 rotations and reflections) with its value (bits 26-27: outcome for
+ * the side to move, bits 28-31: distance to the end of the game in plies, minus one).
+ * Positions where the game is already over are not stored.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "GameEngine.hpp"
+#include "MappedFile.hpp"
+
+/**
+ * @class Tablebase
+ * @brief Perfect-play lookups for small boards: probing a position is one hash-table probe.
+ */
+class Tablebase {
+   public:
+    static constexpr int MAX_SIZE = 4;  ///< 3^16 keys still fit in 26 bits
+
+    enum class Outcome : uint8_t { Loss, Draw, Win };
+
+    /**
+     * @struct Value
+     * @brief Game-theoretic value of a position for the side to move.
+     */
+    struct Value {
+        Outcome outcome{Outcome::Draw};
+        int distance{0};  ///< Plies until the game ends with perfect play
+    };
+
+    /**
+     * @struct Hint
+     * @brief The best move of a position and the value it leads to.
+     */
+    struct Hint {
+        int move{-1};
+        Value value;
+    };
+
+    /**
+     * @brief Maps a tablebase file and validates its header (O(1)).
+     * @param path The tablebase file.
+     * @param error Receives the reason on failure.
+     * @return True if the file is a readable tablebase.
+     */
+    bool open(const std::string& path, std::string& error);
+
+    bool isOpen() const { return slots != nullptr; }
+    int boardSize() const { return size; }
+    size_t positions() const { return entries; }
+
+    /**
+     * @brief Looks up a position that is still being played on a board of boardSize().
+     */
+    std::optional<Value> probe(const GameEngine& game) const;
+
+    /**
+     * @brief Finds the best move: the fastest win, else a draw, else the slowest loss.
+     * @param game A position that is still being played; it is restored before returning.
+     */
+    std::optional<Hint> bestMove(GameEngine& game) const;
+
+    /**
+     * @brief Solves every reachable position of a board size and writes the tablebase file.
+     * @param boardSize 3 or 4.
+     * @param path The file to write.
+     * @param positions Receives the number of positions stored.
+     * @param error Receives the reason on failure.
+     */
+    static bool generate(int boardSize, const std::string& path, size_t& positions,
+                         std::string& error);
+
+    /**
+     * @brief The default file name of the tablebase of a board size, e.g. "tablebase3.bin".
+     */
+    static std::string fileName(int boardSize);
+
+   private:
+    static constexpr char MAGIC[8] = {'T', 'T', 'T', 'B', 'A', 'S', 'E', '\0'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+    static constexpr uint32_t KEY_BITS = 26;
+    static constexpr uint32_t KEY_MASK = (1u << KEY_BITS) - 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t boardSize;
+        uint64_t entries;
+        uint64_t slotCount;  ///< A power of two
+    };
+    static_assert(sizeof(Header) == 32, "unexpected tablebase header layout");
+
+    using Symmetries = std::array<std::vector<int>, 8>;
+
+    MappedFile file;
+    const uint32_t* slots{nullptr};
+    uint64_t slotCount{0};
+    uint64_t entries{0};
+    int size{0};
+    Symmetries symmetries;
+
+    static Symmetries makeSymmetries(int boardSize);
+    static uint32_t canonicalKey(const GameEngine& game, const Symmetries& symmetries);
+    static uint64_t slotOf(uint32_t key, uint64_t slotCount);
+    static uint32_t pack(uint32_t key, const Value& value);
+    static Value unpack(uint32_t slot);
+};
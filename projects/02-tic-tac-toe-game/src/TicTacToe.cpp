@@ -1,19 +1,29 @@
 #include <Sefn/InputUtils.hpp>
 #include <cassert>
-#include <fstream>
+#include <chrono>
 #include <iostream>
-#include <vector>
+#include <optional>
+#include <string>
+
+#include "AlphaBetaSearch.hpp"
+#include "BoardRenderer.hpp"
+#include "GameEngine.hpp"
+#include "MonteCarloSearch.hpp"
+#include "MoveLog.hpp"
+#include "Tablebase.hpp"
 
 class TicTacToe {
     int gridSize = 3;
-    std::vector<std::vector<char>> board;
-    int viableLines;
-    std::vector<char> rowStates, colStates, diagStates;
+    GameEngine engine;
+    BoardRenderer renderer;  // publishes the board for external viewers
+    MoveLogWriter gameLog;   // archives every game to games.bin for tic_tac_toe_analyzer
     bool isXTurn = true;
 
-    // anti-diag (down-left), col (down), main-diag (down-right), row (right)
-    int dr[4]{1, 1, 1, 0};
-    int dc[4]{-1, 0, 1, 1};
+    int computerPlayer = GameEngine::NO_PLAYER;
+    std::chrono::milliseconds thinkTime{1000};
+    std::optional<AlphaBetaSearch> alphaBeta;
+    std::optional<MonteCarloSearch> monteCarlo;
+    Tablebase tablebase;  // open only if tablebase<N>.bin exists for this board size
 
     struct Point {
         int row;
@@ -31,17 +41,21 @@ class TicTacToe {
 
     bool isValid(int r, int c) { return r >= 0 && r < gridSize && c >= 0 && c < gridSize; }
 
-    void displayBoard() {
-        std::ofstream outFile("board.txt");
-        outFile << "\n<============================>\n";
-        for (int i = 0; i < gridSize; ++i) {
-            for (int j = 0; j < gridSize; ++j) {
-                outFile << board[i][j] << " ";
-            }
-            outFile << "\n";
+    static std::string describe(const Tablebase::Value& value) {
+        if (value.outcome == Tablebase::Outcome::Draw) return "draw";
+        return std::string(value.outcome == Tablebase::Outcome::Win ? "win" : "loss") + " in " +
+               std::to_string(value.distance) + " ply(s)";
+    }
+
+    void showHint() {
+        std::optional<Tablebase::Hint> hint = tablebase.bestMove(engine);
+        if (!hint) {
+            std::cout << "\tNo hint: there is no tablebase for this board.\n";
+            return;
         }
-        outFile << "<============================>\n";
-        outFile.close();
+        std::cout << "\tHint: play (" << hint->move / gridSize + 1 << ", "
+                  << hint->move % gridSize + 1 << "), perfect play leads to a "
+                  << describe(hint->value) << " for you.\n";
     }
 
     Point getPlayerInput() {
@@ -51,11 +65,17 @@ class TicTacToe {
             prompt += "x";
         else
             prompt += "o";
-        prompt += " turn. Enter empty location (r, c): ";
+        prompt += " turn. Enter empty location (r, c)";
+        if (tablebase.isOpen()) prompt += ", or 0 0 for a hint";
+        prompt += ": ";
 
         point = Sefn::readValidatedInput<Point>(
             prompt, 0,
             [this](Point p) {
+                if (p.row == 0 && p.col == 0 && tablebase.isOpen()) {
+                    showHint();
+                    return false;
+                }
                 auto [r, c] = --p;  // Decomposes to row, col
                 if (!isValid(r, c)) {
                     std::cout << "\tWrong location, indices must be between 1 and " << gridSize
@@ -63,7 +83,7 @@ class TicTacToe {
                     return false;
                 }
 
-                if (board[r][c] != '.') {
+                if (!engine.isEmpty(engine.cellOf(r, c))) {
                     std::cout << "\tThis location is not empty. Try again\n";
                     return false;
                 }
@@ -74,64 +94,31 @@ class TicTacToe {
         return --point;
     }
 
-    void updateGameState(int r, int c) {
-        char cur = board[r][c];
-
-        // Update Column Status
-        if (colStates[c] == '.') {
-            colStates[c] = cur;
-        } else if (colStates[c] != cur && colStates[c] != '#') {
-            viableLines--;
-            colStates[c] = '#';
-        }
-
-        // Update Row Status
-        if (rowStates[r] == '.') {
-            rowStates[r] = cur;
-        } else if (rowStates[r] != cur && rowStates[r] != '#') {
-            viableLines--;
-            rowStates[r] = '#';
-        }
-
-        // Update Main Diagonal Status
-        if (r == c) {
-            if (diagStates[0] == '.') {
-                diagStates[0] = cur;
-            } else if (diagStates[0] != cur && diagStates[0] != '#') {
-                viableLines--;
-                diagStates[0] = '#';
-            }
-        }
-
-        // Update Anti-Diagonal Status
-        if (r + c == gridSize - 1) {
-            if (diagStates[1] == '.') {
-                diagStates[1] = cur;
-            } else if (diagStates[1] != cur && diagStates[1] != '#') {
-                viableLines--;
-                diagStates[1] = '#';
-            }
+    Point getComputerMove() {
+        int move;
+        std::cout << "Computer (" << GameEngine::symbol(computerPlayer) << ") plays ";
+        if (std::optional<Tablebase::Hint> hint = tablebase.bestMove(engine)) {
+            move = hint->move;
+            std::cout << "(" << move / gridSize + 1 << ", " << move % gridSize + 1 << ")\n"
+                      << "\ttablebase: " << describe(hint->value) << "\n";
+        } else if (alphaBeta) {
+            AlphaBetaSearch::Result result = alphaBeta->search(engine, thinkTime);
+            move = result.move;
+            std::cout << "(" << move / gridSize + 1 << ", " << move % gridSize + 1 << ")\n"
+                      << "\tdepth " << result.depth << (result.solved ? " (solved)" : "")
+                      << ", score " << result.score << ", " << result.nodes << " nodes in "
+                      << result.seconds * 1e3 << " ms, "
+                      << static_cast<long long>(result.nodesPerSecond()) << " nodes/s\n";
+        } else {
+            MonteCarloSearch::Result result = monteCarlo->search(engine, thinkTime);
+            move = result.move;
+            std::cout << "(" << move / gridSize + 1 << ", " << move % gridSize + 1 << ")\n"
+                      << "\twin rate " << result.winRate * 100 << "%, " << result.playouts
+                      << " playouts on " << result.threads << " thread(s) in "
+                      << result.seconds * 1e3 << " ms, "
+                      << static_cast<long long>(result.playoutsPerSecond()) << " playouts/s\n";
         }
-    }
-
-    bool checkLine(int r, int c, int direction) {
-        char cur = board[r][c];
-        for (int i = 1; i < gridSize; ++i) {
-            r += dr[direction];
-            c += dc[direction];
-            if (board[r][c] != cur) {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    bool checkWin(int r, int c) {
-        // Check row (dir 3), col (dir 1), main diag (dir 2), anti diag (dir 0)
-        return (rowStates[r] != '#' && checkLine(r, 0, 3)) ||
-               (colStates[c] != '#' && checkLine(0, c, 1)) ||
-               (diagStates[0] != '#' && r == c && checkLine(0, 0, 2)) ||
-               (diagStates[1] != '#' && r + c == gridSize - 1 && checkLine(0, gridSize - 1, 0));
+        return Point{move / gridSize, move % gridSize};
     }
 
     /**
@@ -140,19 +127,16 @@ class TicTacToe {
      * 2 -> tie!
      */
     int playTurn() {
-        auto [r, c] = getPlayerInput();
+        auto [r, c] = engine.sideToMove() == computerPlayer ? getComputerMove() : getPlayerInput();
 
-        if (isXTurn)
-            board[r][c] = 'x';
-        else
-            board[r][c] = 'o';
-
-        displayBoard();
-        updateGameState(r, c);
+        engine.move(engine.cellOf(r, c));
+        renderer.update(engine);
+        gameLog.recordMove(engine);
 
-        if (checkWin(r, c)) {
+        GameEngine::Status status = engine.status();
+        if (status == GameEngine::Status::Won) {
             return 1;
-        } else if (viableLines == 0) {
+        } else if (status == GameEngine::Status::Draw) {
             return 2;
         }
         isXTurn = !isXTurn;
@@ -160,22 +144,49 @@ class TicTacToe {
     }
 
    public:
-    TicTacToe(int size = 3) {
+    enum class Computer { None, AlphaBeta, MonteCarlo };
+
+    /**
+     * @param size Board side, 3 to 19.
+     * @param winLength Stones in a row needed to win, 3 to size.
+     * @param computer The kind of computer opponent, or Computer::None for two human players.
+     * @param computerPlayer GameEngine::X or GameEngine::O: the side the computer plays.
+     * @param thinkMillis The computer's time budget per move.
+     * @param output How the board is published: rewritten board.txt, board.txt patched in
+     * place, or lines appended to moves.log.
+     */
+    TicTacToe(int size = 3, int winLength = 3, Computer computer = Computer::None,
+              int computerPlayer = GameEngine::NO_PLAYER, int thinkMillis = 1000,
+              BoardRenderer::Mode output = BoardRenderer::Mode::Rewrite)
+        : gridSize(size), engine(size, winLength), renderer(output), thinkTime(thinkMillis) {
         std::cout << "\n*********Welcome*********\n\n";
-        assert(size >= 3 && size < 10);
-        gridSize = size;
-        viableLines = 2 * gridSize + 2;
-        board = std::vector<std::vector<char>>(gridSize, std::vector<char>(gridSize, '.'));
-        rowStates = colStates = std::vector<char>(gridSize, '.');
-        diagStates = std::vector<char>(2, '.');
+        assert(size >= GameEngine::MIN_SIZE && size <= GameEngine::MAX_SIZE);
+        if (computer == Computer::AlphaBeta) alphaBeta.emplace();
+        if (computer == Computer::MonteCarlo) monteCarlo.emplace();
+        if (computer != Computer::None) this->computerPlayer = computerPlayer;
+
+        if (!gameLog.open()) {
+            std::cout << "Cannot open " << MoveLogWriter::DEFAULT_FILE
+                      << ": this game will not be archived.\n";
+        }
+
+        std::string error;
+        if (winLength == size && size <= Tablebase::MAX_SIZE &&
+            tablebase.open(Tablebase::fileName(size), error)) {
+            std::cout << "Loaded the " << size << "x" << size << " tablebase ("
+                      << tablebase.positions() << " positions): perfect play and hints enabled.\n";
+        }
     }
 
     void runGame() {
-        displayBoard();
+        renderer.start(engine);
+        gameLog.startGame(engine);
         int state = 0;
         while (state == 0) {
             state = playTurn();
         }
+        renderer.finish(engine);
+        gameLog.finishGame(engine);
         if (state == 1) {
             std::cout << "\n\tPlayer ";
             if (isXTurn)
@@ -193,9 +204,38 @@ class TicTacToe {
 int main() {
     int size;
     size = Sefn::readValidatedInput<int>(
-        "choose a number(3 - 9) to play with: ", 0, [](int val) { return val >= 3 && val <= 9; },
-        "n must be between 3 and 9. Try again!\n");
-    TicTacToe game(size);
+        "choose a number(3 - 19) to play with: ", 0, [](int val) { return val >= 3 && val <= 19; },
+        "n must be between 3 and 19. Try again!\n");
+    int winLength = Sefn::readValidatedInput<int>(
+        "Stones in a row to win (3 - " + std::to_string(size) + ", " + std::to_string(size) +
+            " for classic TicTacToe, 5 for gomoku): ",
+        0, [size](int val) { return val >= 3 && val <= size; },
+        "It must be between 3 and the board size. Try again!\n");
+    int mode = Sefn::readValidatedInput<int>(
+        "1) Two players\n2) Play against the computer (alpha-beta, best on small boards)\n"
+        "3) Play against the computer (Monte Carlo, multithreaded, for large boards)\n"
+        "Choose a mode: ",
+        0, [](int val) { return val >= 1 && val <= 3; }, "Mode must be 1, 2 or 3. Try again!\n");
+
+    auto computer = static_cast<TicTacToe::Computer>(mode - 1);
+    int computerPlayer = GameEngine::NO_PLAYER;
+    int thinkMillis = 0;
+    if (computer != TicTacToe::Computer::None) {
+        bool humanFirst =
+            Sefn::readValidatedInput<bool>("Do you want to play first (x)? (0 or 1): ");
+        computerPlayer = humanFirst ? GameEngine::O : GameEngine::X;
+        thinkMillis = Sefn::readValidatedInput<int>(
+            "Computer thinking time per move in ms (10 - 60000): ", 0,
+            [](int val) { return val >= 10 && val <= 60000; },
+            "Time must be between 10 and 60000 ms. Try again!\n");
+    }
+    int output = Sefn::readValidatedInput<int>(
+        "Board output for viewers:\n1) Rewrite board.txt every move\n"
+        "2) Update only the changed cell of board.txt (memory-mapped)\n"
+        "3) Append each move to moves.log (tail -f friendly)\nChoose an output: ",
+        0, [](int val) { return val >= 1 && val <= 3; }, "Output must be 1, 2 or 3. Try again!\n");
+    TicTacToe game(size, winLength, computer, computerPlayer, thinkMillis,
+                   static_cast<BoardRenderer::Mode>(output - 1));
     game.runGame();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "TranspositionTable.hpp"
+
+namespace {
+// data layout: score (24 bits, two's complement) | bound (8) | depth + 1 (16) | move + 1 (16)
+constexpr int BOUND_SHIFT = 24;
+constexpr int DEPTH_SHIFT = 32;
+constexpr int MOVE_SHIFT = 48;
+constexpr uint64_t SCORE_MASK = 0xFFFFFF;
+}  // namespace
+
+TranspositionTable::TranspositionTable(size_t entries) {
+    size_t size = 1;
+    while (size < entries) size <<= 1;
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+}
+
+uint64_t TranspositionTable::pack(const Entry& entry) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(entry.score)) & SCORE_MASK) |
+           static_cast<uint64_t>(entry.bound) << BOUND_SHIFT |
+           static_cast<uint64_t>(static_cast<uint16_t>(entry.depth + 1)) << DEPTH_SHIFT |
+           static_cast<uint64_t>(static_cast<uint16_t>(entry.move + 1)) << MOVE_SHIFT;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data) {
+    Entry entry;
+    uint32_t score = static_cast<uint32_t>(data & SCORE_MASK);
+    // Sign-extend the 24-bit score
+    entry.score = static_cast<int>(score ^ 0x800000) - 0x800000;
+    entry.bound = static_cast<Bound>((data >> BOUND_SHIFT) & 0xFF);
+    entry.depth = static_cast<int>((data >> DEPTH_SHIFT) & 0xFFFF) - 1;
+    entry.move = static_cast<int>((data >> MOVE_SHIFT) & 0xFFFF) - 1;
+    return entry;
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry& entry) const {
+    const Slot& slot = slots[key & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+    // Empty slots hold (0, 0), which matches only key 0; an entry of depth -1 is never useful
+    if ((check ^ data) != key || data == 0) return false;
+    entry = unpack(data);
+    return true;
+}
+
+void TranspositionTable::store(uint64_t key, const Entry& entry) {
+    Slot& slot = slots[key & mask];
+    uint64_t data = pack(entry);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; ++i) {
+        slots[i].data.store(0, std::memory_order_relaxed);
+        slots[i].check.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file TranspositionTable.hpp
+ * @brief Lock-free cache of search results, safe to share between search threads.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class TranspositionTable
+ * @brief Fixed-size, always-replace hash table of search results keyed by Zobrist hash.
+ *
+ * Each slot is two 64-bit atomics: the packed entry, and the key XOR-ed with it. A reader
+ * accepts a slot only if the two words still agree with its key, so an entry torn by a
+ * concurrent writer reads as a miss instead of as a wrong result, without any lock.
+ */
+class TranspositionTable {
+   public:
+    enum Bound : uint8_t { EXACT, LOWER, UPPER };
+
+    /**
+     * @struct Entry
+     * @brief One cached search result. Scores must fit in 24 bits.
+     */
+    struct Entry {
+        int score{0};
+        int depth{-1};
+        Bound bound{EXACT};
+        int move{-1};
+    };
+
+    /**
+     * @param entries Number of slots, rounded up to a power of two.
+     */
+    explicit TranspositionTable(size_t entries);
+
+    /**
+     * @brief Looks a position up.
+     * @return True and the entry if the position is cached.
+     */
+    bool probe(uint64_t key, Entry& entry) const;
+
+    void store(uint64_t key, const Entry& entry);
+
+    /**
+     * @brief Forgets every entry. Not safe while other threads use the table.
+     */
+    void clear();
+
+    size_t size() const { return mask + 1; }
+
+   private:
+    struct Slot {
+        std::atomic<uint64_t> check{0};  ///< key ^ data
+        std::atomic<uint64_t> data{0};
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+
+    static uint64_t pack(const Entry& entry);
+    static Entry unpack(uint64_t data);
+};
@@ -0,0 +1,110 @@
+/**
+ * @file GameAnalyzer.cpp
+ * @brief Bulk analysis of archived games: blunders, best-move agreement and game lengths.
+ *
+ * Usage:
+ *     tic_tac_toe_analyzer <move log> [max depth] [ms per position] [threads] [annotations]
+ *
+ * tic_tac_toe appends every game it plays to games.bin. Defaults: unlimited depth, 100 ms per
+ * position, one thread per hardware thread, no annotation file. The annotation file lists
+ * every move with the engine's best move and both scores.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "GameAnalyzer.hpp"
+
+namespace {
+const char* RESULT_NAMES[] = {"x won", "o won", "draw", "abandoned"};
+
+std::string cellName(int cell, int size) {
+    return "(" + std::to_string(cell / size + 1) + ", " + std::to_string(cell % size + 1) + ")";
+}
+
+void writeAnnotations(std::ofstream& out, const std::vector<LoggedGame>& games,
+                      const std::vector<GameAnalysis>& analyses) {
+    for (size_t i = 0; i < games.size(); ++i) {
+        const LoggedGame& game = games[i];
+        out << "game " << i + 1 << ": " << game.size << "x" << game.size << ", "
+            << game.winLength << " in a row, "
+            << RESULT_NAMES[static_cast<size_t>(game.result)] << "\n";
+        for (size_t ply = 0; ply < analyses[i].moves.size(); ++ply) {
+            const MoveAnnotation& move = analyses[i].moves[ply];
+            out << std::setw(5) << ply + 1 << ". " << GameEngine::symbol(ply % 2) << " "
+                << std::left << std::setw(10) << cellName(move.move, game.size) << std::right
+                << " score " << std::setw(8) << move.playedScore << "   best "
+                << std::left << std::setw(10) << cellName(move.bestMove, game.size) << std::right
+                << " score " << std::setw(8) << move.bestScore
+                << (move.blunder ? "   ?? blunder" : move.agrees ? "" : "   ?") << "\n";
+        }
+        if (!analyses[i].error.empty()) out << "  invalid: " << analyses[i].error << "\n";
+    }
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 6) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <move log> [max depth] [ms per position] [threads] [annotations]\n";
+        return 1;
+    }
+    AnalysisConfig config;
+    if (argc > 2 && std::atoi(argv[2]) > 0) config.maxDepth = std::atoi(argv[2]);
+    if (argc > 3) config.budget = std::chrono::milliseconds(std::max(1, std::atoi(argv[3])));
+    if (argc > 4) config.threads = std::max(0, std::atoi(argv[4]));
+
+    std::vector<LoggedGame> games;
+    std::string error;
+    if (!readMoveLog(argv[1], games, error)) {
+        std::cerr << "Cannot read the move log: " << error << "\n";
+        return 1;
+    }
+
+    AnalysisSummary summary;
+    std::vector<GameAnalysis> analyses = analyzeGames(games, config, summary);
+
+    double seconds = summary.seconds > 0 ? summary.seconds : 1e-9;
+    std::cout << std::fixed << std::setprecision(2) << summary.games << " games ("
+              << summary.invalidGames << " invalid), " << summary.moves << " moves, "
+              << summary.threads << " thread(s), " << summary.seconds << " s\n"
+              << "games/s       " << static_cast<long long>(summary.games / seconds) << "\n"
+              << "moves/s       " << static_cast<long long>(summary.moves / seconds) << "\n"
+              << "nodes/s       " << static_cast<long long>(summary.nodes / seconds) << "\n\n";
+
+    for (size_t r = 0; r < summary.results.size(); ++r) {
+        std::cout << std::left << std::setw(14) << RESULT_NAMES[r] << std::right
+                  << summary.results[r] << "\n";
+    }
+    std::cout << "\nplayer     moves   agreement    blunders\n";
+    for (int player : {GameEngine::X, GameEngine::O}) {
+        double moves = summary.playerMoves[player] ? summary.playerMoves[player] : 1;
+        std::cout << std::setw(6) << GameEngine::symbol(player) << std::setw(10)
+                  << summary.playerMoves[player] << std::setw(11)
+                  << 100 * summary.agreements[player] / moves << "%" << std::setw(12)
+                  << summary.blunders[player] << "\n";
+    }
+
+    uint64_t valid = summary.games - summary.invalidGames;
+    std::cout << "\ngame length distribution\n";
+    for (size_t length = 0; length < summary.lengths.size(); ++length) {
+        if (summary.lengths[length] == 0) continue;
+        double share = 100.0 * summary.lengths[length] / valid;
+        std::cout << std::setw(6) << length << " moves " << std::setw(7) << share << "% "
+                  << std::string(static_cast<size_t>(share / 2), '#') << "\n";
+    }
+
+    if (argc > 5) {
+        std::ofstream out(argv[5]);
+        if (!out) {
+            std::cerr << "Cannot write " << argv[5] << "\n";
+            return 1;
+        }
+        writeAnnotations(out, games, analyses);
+        std::cout << "\nAnnotations written to " << argv[5] << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file TablebaseGenerator.cpp
+ * @brief Solves every reachable position of a small board and writes its tablebase.
+ *
+ * Usage:
+ *     tic_tac_toe_tablebase <size 3 or 4> [output]   (default output: tablebase<size>.bin)
+ *
+ * tic_tac_toe loads tablebase<size>.bin from its working directory at startup.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Tablebase.hpp"
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <size 3 or 4> [output]\n";
+        return 1;
+    }
+    int size = std::atoi(argv[1]);
+    std::string path = argc == 3 ? argv[2] : Tablebase::fileName(size);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t positions = 0;
+    std::string error;
+    if (!Tablebase::generate(size, path, positions, error)) {
+        std::cerr << "Generation failed: " << error << "\n";
+        return 1;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Wrote " << positions << " canonical positions to " << path << " in "
+              << elapsed.count() << " s\n";
+    return 0;
+}
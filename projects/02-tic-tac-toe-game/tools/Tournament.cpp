@@ -0,0 +1,96 @@
+/**
+ * @file Tournament.cpp
+ * @brief Headless self-play between two policies: throughput, results and move latencies.
+ *
+ * Usage:
+ *     tic_tac_toe_tournament <policy A> <policy B> [games] [size] [win length] [threads]
+ *
+ * Policies are `random`, `greedy`, `alphabeta[:ms per move]` or `mcts[:playouts per move]`.
+ * Defaults: 100000 games on 3x3, win length = size, one thread per hardware thread. The two
+ * policies swap colors every game. Nothing is written to disk.
+ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "SelfPlay.hpp"
+
+namespace {
+void printLatency(const std::string& name, const LatencyHistogram& latency) {
+    std::cout << std::left << std::setw(18) << name << std::right << std::setw(12)
+              << static_cast<long long>(latency.meanNanos());
+    for (double fraction : {0.5, 0.9, 0.99, 0.999}) {
+        std::cout << std::setw(12) << latency.percentile(fraction);
+    }
+    std::cout << "\n";
+}
+
+void printHistogram(const LatencyHistogram& latency) {
+    for (int i = 0; i < LatencyHistogram::BUCKETS; ++i) {
+        if (latency.buckets[i] == 0) continue;
+        double share = 100.0 * latency.buckets[i] / latency.count;
+        std::cout << "    < " << std::setw(12) << (uint64_t{1} << (i + 1)) << " ns " << std::setw(7)
+                  << share << "% " << std::string(static_cast<size_t>(share / 2), '#') << "\n";
+    }
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 7) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <policy A> <policy B> [games] [size] [win length] [threads]\n"
+                  << "Policies: random, greedy, alphabeta[:ms], mcts[:playouts]\n";
+        return 1;
+    }
+
+    TournamentConfig config;
+    try {
+        config.first = PolicySpec::parse(argv[1]);
+        config.second = PolicySpec::parse(argv[2]);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    config.games = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100000;
+    config.size = argc > 4 ? std::atoi(argv[4]) : 3;
+    config.winLength = argc > 5 ? std::atoi(argv[5]) : config.size;
+    config.threads = argc > 6 ? std::atoi(argv[6]) : 0;
+    if (config.games == 0 || config.size < GameEngine::MIN_SIZE ||
+        config.size > GameEngine::MAX_SIZE || config.winLength < GameEngine::MIN_WIN_LENGTH ||
+        config.winLength > config.size || config.threads < 0) {
+        std::cerr << "Need games > 0, size 3-19, win length 3-size and threads >= 0\n";
+        return 1;
+    }
+
+    std::string nameA = "A " + config.first.toString();
+    std::string nameB = "B " + config.second.toString();
+    TournamentResult result = runTournament(config);
+
+    double games = static_cast<double>(result.games);
+    std::cout << std::fixed << std::setprecision(2) << nameA << " vs " << nameB << ", "
+              << result.games << " games on " << config.size << "x" << config.size << " ("
+              << config.winLength << " in a row), " << result.threads << " thread(s)\n\n"
+              << "time          " << result.seconds << " s\n"
+              << "games/s       " << static_cast<long long>(result.gamesPerSecond()) << "\n"
+              << "moves/s       " << static_cast<long long>(result.movesPerSecond()) << "\n"
+              << "moves/game    " << result.moves / games << "\n\n"
+              << "A wins        " << 100 * result.firstWins / games << "%\n"
+              << "B wins        " << 100 * result.secondWins / games << "%\n"
+              << "draws         " << 100 * result.draws / games << "%\n"
+              << "x / o wins    " << 100 * result.xWins / games << "% / "
+              << 100 * result.oWins / games << "%\n\n";
+
+    std::cout << "move latency (ns)" << std::setw(13) << "mean" << std::setw(12) << "p50"
+              << std::setw(12) << "p90" << std::setw(12) << "p99" << std::setw(12) << "p99.9"
+              << "\n";
+    printLatency(nameA, result.latency[0]);
+    printLatency(nameB, result.latency[1]);
+    for (int i = 0; i < 2; ++i) {
+        std::cout << "\n" << (i == 0 ? nameA : nameB) << "\n";
+        printHistogram(result.latency[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file ConcurrencyStress.cpp
+ * @brief Hammers a concurrent HospitalSystem with registration desks and doctors.
+ *
+ * Usage: hospital_concurrency_stress [producers] [consumers] [patients per producer]
+ *                                    [specializations] [levels] [group size]
+ * (defaults: 4, 4, 250000, 20, 5, 1)
+ *
+ * Producers admit patients to random specializations and levels while consumers call the next
+ * patient of every specialization in turn. With a group size above 1, consecutive
+ * specializations form groups, so a doctor finding one queue empty steals from a sibling while
+ * the desks keep admitting. Each patient's name encodes a unique number, so afterwards the
+ * tool checks that every patient was called exactly once, and that each doctor saw the
+ * patients one desk sent to one specialization and level in the order they were sent.
+ * Finally it fills one specialization without contention and checks the urgent-first order of
+ * a single-threaded drain.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "HospitalSystem.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int NAME_LETTERS = 7;  ///< 26^7 distinct names
+
+std::string encodeName(uint64_t id) {
+    std::string name(NAME_LETTERS + 1, 'p');
+    for (int i = NAME_LETTERS; i >= 1; --i, id /= 26) name[i] = static_cast<char>('a' + id % 26);
+    return name;
+}
+
+uint64_t decodeName(const std::string &name) {
+    uint64_t id = 0;
+    for (int i = 1; i <= NAME_LETTERS; ++i) id = id * 26 + static_cast<uint64_t>(name[i] - 'a');
+    return id;
+}
+
+struct ConsumerStats {
+    uint64_t called{0};
+    uint64_t outOfOrder{0};  ///< Same desk, specialization and level, but older than the last
+    uint64_t stolen{0};      ///< Called from a sibling of the specialization asked for
+};
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    int producers = argc > 1 ? std::atoi(argv[1]) : 4;
+    int consumers = argc > 2 ? std::atoi(argv[2]) : 4;
+    long long perProducer = argc > 3 ? std::atoll(argv[3]) : 250000;
+    int specs = argc > 4 ? std::atoi(argv[4]) : 20;
+    int levels = argc > 5 ? std::atoi(argv[5]) : 5;
+    int groupSize = argc > 6 ? std::atoi(argv[6]) : 1;
+    if (producers < 1 || consumers < 1 || perProducer < 1 || specs < 1 || levels < 1 ||
+        levels > TriageQueue<int>::MAX_LEVELS || groupSize < 1) {
+        std::cerr << "Usage: hospital_concurrency_stress [producers] [consumers] "
+                     "[patients per producer] [specializations] [levels 1-64] [group size]\n";
+        return 1;
+    }
+    const uint64_t total = static_cast<uint64_t>(producers) * perProducer;
+
+    HospitalSystem hospital(specs, levels, HospitalSystem::UNLIMITED, true);
+    std::vector<std::vector<int>> groups;
+    for (int s = 0; s < specs; ++s) {
+        if (s % groupSize == 0) groups.emplace_back();
+        groups.back().push_back(s);
+    }
+    hospital.setGroups(groups);
+    std::vector<std::atomic<uint8_t>> seen(total);
+    std::atomic<uint64_t> called{0};
+    std::atomic<uint64_t> fullRetries{0};
+    std::vector<ConsumerStats> stats(consumers);
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(1000 + t);
+            std::uniform_int_distribution<int> spec(0, specs - 1);
+            std::uniform_int_distribution<int> level(1, levels);
+            uint64_t retries = 0;
+            for (long long seq = 0; seq < perProducer; ++seq) {
+                Patient p(encodeName(static_cast<uint64_t>(t) * perProducer + seq), level(rng));
+                int s = spec(rng);
+                while (!hospital.admit(s, p)) {
+                    ++retries;  // the doctors are behind: wait for them
+                    std::this_thread::yield();
+                }
+            }
+            fullRetries += retries;
+        });
+    }
+    for (int t = 0; t < consumers; ++t) {
+        threads.emplace_back([&, t] {
+            ConsumerStats &mine = stats[t];
+            // Last sequence number seen per (desk, specialization, level)
+            std::vector<long long> last(static_cast<size_t>(producers) * specs * levels, -1);
+            int s = t % specs;
+            while (called.load(std::memory_order_relaxed) < total) {
+                int from = s;
+                std::optional<Patient> p = hospital.callNext(s, &from);
+                if (p && from != s) ++mine.stolen;
+                s = (s + 1) % specs;
+                if (!p) continue;
+                uint64_t id = decodeName(p->name);
+                if (id >= total) {
+                    ++mine.outOfOrder;
+                    continue;
+                }
+                seen[id].fetch_add(1, std::memory_order_relaxed);
+                long long seq = static_cast<long long>(id % perProducer);
+                size_t key = ((id / perProducer) * specs + from) * levels + (p->level - 1);
+                if (seq < last[key]) ++mine.outOfOrder;
+                last[key] = seq;
+                ++mine.called;
+                called.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (std::thread &thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint64_t lost = 0, duplicated = 0, outOfOrder = 0, stolen = 0;
+    for (auto &count : seen) {
+        uint8_t n = count.load();
+        if (n == 0) ++lost;
+        if (n > 1) ++duplicated;
+    }
+    for (const ConsumerStats &s : stats) {
+        outOfOrder += s.outOfOrder;
+        stolen += s.stolen;
+    }
+
+    // Urgent-first order once the queue is quiet
+    HospitalSystem quiet(1, levels, HospitalSystem::UNLIMITED, true);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> level(1, levels);
+    const int QUIET_PATIENTS = 1000;
+    for (int i = 0; i < QUIET_PATIENTS; ++i) quiet.admit(0, Patient(encodeName(i), level(rng)));
+    bool triageOrder = true;
+    Patient previous("", 1);
+    uint64_t previousId = 0;
+    int drained = 0;
+    while (std::optional<Patient> p = quiet.callNext(0)) {
+        uint64_t id = decodeName(p->name);
+        if (drained > 0 && (p->level < previous.level ||
+                            (p->level == previous.level && id < previousId))) {
+            triageOrder = false;
+        }
+        previous = *p;
+        previousId = id;
+        ++drained;
+    }
+    triageOrder = triageOrder && drained == QUIET_PATIENTS;
+
+    std::cout << producers << " producers, " << consumers << " consumers, " << total
+              << " patients, " << specs << " specializations, " << levels << " levels, groups of "
+              << groupSize << "\n"
+              << std::fixed << std::setprecision(3) << "time:           " << seconds << " s\n"
+              << std::setprecision(0) << "throughput:     " << 2 * total / seconds
+              << " ops/s (admit + call)\n"
+              << "full retries:   " << fullRetries.load() << "\n"
+              << "stolen:         " << stolen << "\n"
+              << "lost:           " << lost << "\n"
+              << "duplicated:     " << duplicated << "\n"
+              << "out of order:   " << outOfOrder << "\n"
+              << "urgent first:   " << (triageOrder ? "ok" : "WRONG") << "\n";
+    bool ok = lost == 0 && duplicated == 0 && outOfOrder == 0 && triageOrder;
+    std::cout << (ok ? "PASS" : "FAIL") << "\n";
+    return ok ? 0 : 1;
+}
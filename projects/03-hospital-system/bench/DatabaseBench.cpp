@@ -0,0 +1,192 @@
+/**
+ * @file DatabaseBench.cpp
+ * @brief Compares loading the text and the binary database, and damages the binary one.
+ *
+ * Usage: hospital_database_bench [patients] [specializations] [levels] [damaged bytes]
+ * (defaults: 2000000, 20, 5, 100)
+ *
+ * Writes the same random patients in both formats, then times loading each into the queues,
+ * and decoding the binary file alone. Finally it overwrites random bytes of the binary file
+ * and checks that loading it keeps exactly the records no damaged byte fell into, in order.
+ * The files are written to the current directory and removed afterwards.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BinaryDatabase.hpp"
+#include "HospitalQueue.hpp"
+#include "WriteAheadLog.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+const char *TEXT_FILE = "database_bench.txt";
+const char *BINARY_FILE = "database_bench.bin";
+const char *DAMAGED_FILE = "database_bench_damaged.bin";
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Queued {
+    int spec;
+    Patient patient;
+};
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    long long patients = argc > 1 ? std::atoll(argv[1]) : 2000000;
+    int specs = argc > 2 ? std::atoi(argv[2]) : 20;
+    int levels = argc > 3 ? std::atoi(argv[3]) : 5;
+    long long damage = argc > 4 ? std::atoll(argv[4]) : 100;
+    if (patients < 1 || specs < 1 || levels < 1 || levels > TriageQueue<int>::MAX_LEVELS ||
+        damage < 0) {
+        std::cerr << "Usage: hospital_database_bench [patients] [specializations] "
+                     "[levels 1-64] [damaged bytes]\n";
+        return 1;
+    }
+
+    // The patients in file order: by specialization, then call order
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> nameLength(3, 20);
+    std::uniform_int_distribution<int> level(1, levels);
+    std::vector<HospitalQueue> queues;
+    for (int s = 0; s < specs; ++s) {
+        queues.emplace_back(s, levels, TriageQueue<Patient>::UNBOUNDED);
+    }
+    for (long long i = 0; i < patients; ++i) {
+        std::string name(nameLength(rng), ' ');
+        for (size_t c = 0; c < name.size(); ++c) {
+            if (c == 0 || name[c - 1] == ' ' || c + 1 == name.size() || rng() % 6) {
+                name[c] = static_cast<char>(letter(rng));
+            }
+        }
+        queues[rng() % specs].push(Patient(name, level(rng)));
+    }
+    std::vector<Queued> expected;
+    std::ostringstream text;
+    text << "#checkpoint 7\n";
+    BinaryDatabase::Writer writer(7);
+    std::vector<size_t> recordEnds;  ///< Where each record of the binary file ends
+    for (const HospitalQueue &queue : queues) {
+        text << queue.toString() << "\n";
+        queue.forEach([&](const Patient &p) {
+            expected.push_back({queue.id, p});
+            writer.add(queue.id, p);
+            recordEnds.push_back(writer.contents().size());
+        });
+    }
+    if (!durableReplace(TEXT_FILE, text.str()) ||
+        !durableReplace(BINARY_FILE, writer.contents())) {
+        std::cerr << "Cannot write the database files\n";
+        return 1;
+    }
+    double textMegabytes = text.str().size() / 1e6;
+    double binaryMegabytes = writer.contents().size() / 1e6;
+
+    // Text, as loadTextDatabase() reads it
+    auto start = Clock::now();
+    size_t textLoaded = 0;
+    {
+        std::ifstream file(TEXT_FILE);
+        std::string line;
+        std::vector<HospitalQueue> loaded;
+        while (getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            loaded.emplace_back(line, levels, TriageQueue<Patient>::UNBOUNDED);
+            textLoaded += loaded.back().size();
+        }
+    }
+    double textSeconds = secondsSince(start);
+
+    std::string error;
+    BinaryDatabase::ReadResult result;
+    start = Clock::now();
+    size_t binaryLoaded = 0;
+    {
+        std::vector<HospitalQueue> loaded;
+        for (int s = 0; s < specs; ++s) {
+            loaded.emplace_back(s, levels, TriageQueue<Patient>::UNBOUNDED);
+        }
+        auto load = [&](int spec, Patient p) { binaryLoaded += loaded[spec].push(std::move(p)); };
+        if (!BinaryDatabase::read(BINARY_FILE, load, result, error)) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+    }
+    double binarySeconds = secondsSince(start);
+
+    start = Clock::now();
+    size_t decoded = 0;
+    BinaryDatabase::read(BINARY_FILE, [&](int, Patient) { ++decoded; }, result, error);
+    double decodeSeconds = secondsSince(start);
+
+    // Damage: every overwritten byte may cost the record it falls into, and nothing else
+    std::string damaged = writer.contents();
+    std::vector<bool> hit(expected.size(), false);
+    std::uniform_int_distribution<size_t> position(sizeof(BinaryDatabase::Header),
+                                                   damaged.size() - 1);
+    for (long long i = 0; i < damage; ++i) {
+        size_t at = position(rng);
+        damaged[at] = static_cast<char>(damaged[at] ^ (1 + rng() % 255));
+        hit[std::upper_bound(recordEnds.begin(), recordEnds.end(), at) - recordEnds.begin()] =
+            true;
+    }
+    durableReplace(DAMAGED_FILE, damaged);
+    std::vector<Queued> survivors;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (!hit[i]) survivors.push_back(expected[i]);
+    }
+    size_t next = 0, mismatches = 0;
+    BinaryDatabase::ReadResult damagedResult;
+    auto check = [&](int spec, Patient p) {
+        if (next >= survivors.size() || survivors[next].spec != spec ||
+            survivors[next].patient.name != p.name ||
+            survivors[next].patient.level != p.level) {
+            ++mismatches;
+        }
+        ++next;
+    };
+    bool readable = BinaryDatabase::read(DAMAGED_FILE, check, damagedResult, error);
+
+    std::error_code ignored;
+    for (const char *file : {TEXT_FILE, BINARY_FILE, DAMAGED_FILE}) {
+        std::filesystem::remove(file, ignored);
+    }
+
+    bool ok = textLoaded == expected.size() && binaryLoaded == expected.size() &&
+              decoded == expected.size() && readable && mismatches == 0 &&
+              next == survivors.size() && damagedResult.checkpointLsn == 7;
+    std::cout << expected.size() << " patients, " << specs << " specializations, " << levels
+              << " levels\n"
+              << std::fixed << std::setprecision(1) << std::setw(16) << "" << std::setw(10)
+              << "MB" << std::setw(10) << "ms" << std::setw(10) << "MB/s" << std::setw(14)
+              << "ns/patient" << "\n";
+    auto row = [&](const char *name, double megabytes, double seconds) {
+        std::cout << std::setw(16) << name << std::setw(10) << megabytes << std::setw(10)
+                  << 1000 * seconds << std::setw(10) << megabytes / seconds << std::setw(14)
+                  << 1e9 * seconds / expected.size() << "\n";
+    };
+    row("text load", textMegabytes, textSeconds);
+    row("binary load", binaryMegabytes, binarySeconds);
+    row("binary decode", binaryMegabytes, decodeSeconds);
+    std::cout << damage << " damaged bytes hit " << expected.size() - survivors.size()
+              << " records: kept " << next << " of " << survivors.size() << " intact ones, "
+              << damagedResult.damaged << " damaged parts skipped, " << mismatches
+              << " mismatches\n"
+              << (ok ? "PASS" : "FAIL") << "\n";
+    return ok ? 0 : 1;
+}
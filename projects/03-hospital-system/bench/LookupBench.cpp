@@ -0,0 +1,157 @@
+/**
+ * @file LookupBench.cpp
+ * @brief Measures PatientIndex lookups against scanning the queues, and checks its ranks.
+ *
+ * Usage: hospital_lookup_bench [patients] [specializations] [levels] [aging minutes]
+ * (defaults: 1000000, 20, 5, 0 for strict triage order)
+ *
+ * Queues the patients at random specializations and levels, then admits and calls as many
+ * again in random order, keeping an index of them all. It then walks every queue in call
+ * order and checks the index's rank of every patient, and times exact and prefix lookups and
+ * a scan of the queues like printing them. Every lookup must find its patient.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "HospitalQueue.hpp"
+#include "PatientIndex.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int NAME_LETTERS = 6;  ///< 26^6 distinct names
+
+std::string nameOf(uint64_t id) {
+    std::string name(NAME_LETTERS, 'a');
+    for (int i = NAME_LETTERS - 1; i >= 0; --i, id /= 26) {
+        name[i] = static_cast<char>('a' + id % 26);
+    }
+    return name;
+}
+
+double nanosSince(Clock::time_point start, uint64_t operations) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / operations;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    long long patients = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    int specs = argc > 2 ? std::atoi(argv[2]) : 20;
+    int levels = argc > 3 ? std::atoi(argv[3]) : 5;
+    double agingMinutes = argc > 4 ? std::atof(argv[4]) : 0;
+    if (patients < 1 || specs < 1 || levels < 1 || levels > TriageQueue<int>::MAX_LEVELS ||
+        agingMinutes < 0) {
+        std::cerr << "Usage: hospital_lookup_bench [patients] [specializations] [levels 1-64]"
+                     " [aging minutes]\n";
+        return 1;
+    }
+    auto agingStep = static_cast<int64_t>(agingMinutes * 60e9);
+
+    std::vector<HospitalQueue> queues;
+    for (int s = 0; s < specs; ++s) {
+        queues.emplace_back(s, levels, TriageQueue<Patient>::UNBOUNDED, false, agingStep);
+    }
+    PatientIndex index(levels, agingStep);
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> spec(0, specs - 1);
+    std::uniform_int_distribution<int> level(1, levels);
+    uint64_t nextId = 0;
+
+    auto admit = [&] {
+        Patient p(nameOf(nextId++), level(rng));
+        p.enqueuedAt = Patient::now();
+        int s = spec(rng);
+        queues[s].push(p);
+        index.add(s, p);
+    };
+    auto start = Clock::now();
+    for (long long i = 0; i < patients; ++i) admit();
+    double addNanos = nanosSince(start, patients);
+
+    // As many admits and calls again, interleaved
+    std::bernoulli_distribution coin(0.5);
+    start = Clock::now();
+    for (long long i = 0; i < patients; ++i) {
+        if (coin(rng)) {
+            admit();
+        } else {
+            int s = spec(rng);
+            if (std::optional<Patient> p = queues[s].pop()) index.remove(s, *p);
+        }
+    }
+    double churnNanos = nanosSince(start, patients);
+
+    // Every rank against the real call order
+    uint64_t checked = 0, wrong = 0;
+    std::vector<std::string> waiting;
+    for (int s = 0; s < specs; ++s) {
+        size_t ahead = 0;
+        std::vector<size_t> aheadInLevel(levels, 0);
+        queues[s].forEach([&](const Patient &p) {
+            std::vector<PatientLocation> found = index.find(p.name);
+            if (found.size() != 1 || found[0].specialization != s ||
+                found[0].level != p.level || found[0].ahead != ahead ||
+                found[0].aheadInLevel != aheadInLevel[p.level - 1]) {
+                ++wrong;
+            }
+            ++checked;
+            ++ahead;
+            ++aheadInLevel[p.level - 1];
+            waiting.push_back(p.name);
+        });
+    }
+    if (index.size() != checked) ++wrong;
+
+    // Random names, read in order, so that only the index misses the cache
+    std::shuffle(waiting.begin(), waiting.end(), rng);
+    const uint64_t LOOKUPS = 1000000;
+    start = Clock::now();
+    for (uint64_t i = 0; i < LOOKUPS; ++i) {
+        if (index.find(waiting[i % waiting.size()]).empty()) ++wrong;
+    }
+    double findNanos = nanosSince(start, LOOKUPS);
+
+    std::uniform_int_distribution<size_t> pick(0, waiting.size() - 1);
+    const uint64_t PREFIX_LOOKUPS = 100000;
+    uint64_t prefixMatches = 0;
+    start = Clock::now();
+    for (uint64_t i = 0; i < PREFIX_LOOKUPS; ++i) {
+        prefixMatches += index.findPrefix(waiting[pick(rng)].substr(0, 3), 10).size();
+    }
+    double prefixNanos = nanosSince(start, PREFIX_LOOKUPS);
+
+    // What finding a patient costs without the index: read the queues until the name shows up
+    const uint64_t SCANS = 20;
+    start = Clock::now();
+    for (uint64_t i = 0; i < SCANS; ++i) {
+        const std::string &name = waiting[pick(rng)];
+        bool found = false;
+        for (const HospitalQueue &queue : queues) {
+            if (found) break;
+            queue.forEach([&](const Patient &p) { found = found || p.name == name; });
+        }
+        if (!found) ++wrong;
+    }
+    double scanNanos = nanosSince(start, SCANS);
+
+    std::cout << checked << " patients waiting in " << specs << " specializations, " << levels
+              << " levels, " << (agingStep > 0 ? "aging" : "strict triage order") << "\n"
+              << std::fixed << std::setprecision(1) << "admit + index:     " << addNanos
+              << " ns\n"
+              << "admit or call:     " << churnNanos << " ns\n"
+              << "find by name:      " << findNanos << " ns\n"
+              << "find by prefix:    " << prefixNanos << " ns (3 letters, "
+              << static_cast<double>(prefixMatches) / PREFIX_LOOKUPS << " patients found)\n"
+              << "scan the queues:   " << scanNanos / 1000 << " us\n"
+              << "wrong:             " << wrong << "\n"
+              << (wrong == 0 ? "PASS" : "FAIL") << "\n";
+    return wrong == 0 ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file StealingBench.cpp
+ * @brief Simulates unevenly loaded specializations with and without work stealing.
+ *
+ * Usage: hospital_stealing_bench [hours] [capacity] [busy rate] [quiet rate]
+ * (defaults: 8760 hours, 10 patients, 7 and 3 arrivals an hour)
+ *
+ * Four specializations with one doctor each and 12-minute services, so each doctor can see 5
+ * patients an hour: specialization 1 gets the busy rate, the others the quiet rate. Alone, the
+ * busy one turns patients away while the quiet doctors sit idle; grouped, idle doctors take
+ * its patients. Every row is the same arrival sequence (same seed).
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Simulation.hpp"
+
+int main(int argc, char *argv[]) {
+    SimulationConfig config;
+    config.specializations = 4;
+    config.doctors = {1};
+    config.serviceMinutes = 12;
+    config.hours = argc > 1 ? std::atof(argv[1]) : 24 * 365;
+    config.capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+    double busy = argc > 3 ? std::atof(argv[3]) : 7;
+    double quiet = argc > 4 ? std::atof(argv[4]) : 3;
+    config.arrivalsPerHour = {busy, quiet};
+
+    std::cout << config.hours << " hours, 4 specializations of 1 doctor, capacity "
+              << config.capacity << ", " << busy << " and 3 x " << quiet
+              << " arrivals an hour; waits in minutes\n\n"
+              << std::setw(12) << "groups" << std::setw(12) << "events/s" << std::setw(10)
+              << "served" << std::setw(10) << "rejected" << std::setw(10) << "vs none"
+              << std::setw(10) << "steals" << std::setw(10) << "mean" << std::setw(10) << "max"
+              << std::setw(12) << "spec 1 p99" << "\n"
+              << std::fixed << std::setprecision(1);
+    uint64_t baseline = 0;
+    const std::vector<std::pair<const char *, std::vector<std::vector<int>>>> layouts = {
+        {"none", {}}, {"1+2, 3+4", {{0, 1}, {2, 3}}}, {"1-4", {{0, 1, 2, 3}}}};
+    for (const auto &[name, groups] : layouts) {
+        config.groups = groups;
+        SimulationReport report;
+        try {
+            report = simulate(config);
+        } catch (const std::invalid_argument &e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        uint64_t served = 0, rejected = 0, steals = 0;
+        double waitSum = 0, maxWait = 0;
+        for (const SpecializationReport &spec : report.specializations) {
+            served += spec.served;
+            rejected += spec.rejected;
+            steals += spec.stealsIn;
+            waitSum += spec.wait.mean * spec.wait.patients;
+            maxWait = std::max(maxWait, spec.wait.max);
+        }
+        if (groups.empty()) baseline = rejected;
+        std::string change = "-";
+        if (!groups.empty() && baseline > 0) {
+            change = std::to_string(static_cast<int>(
+                         100.0 * (static_cast<double>(rejected) - baseline) / baseline)) +
+                     "%";
+        }
+        std::cout << std::setw(12) << name << std::setw(12)
+                  << static_cast<long long>(report.eventsPerSecond()) << std::setw(10) << served
+                  << std::setw(10) << rejected << std::setw(10) << change << std::setw(10)
+                  << steals << std::setw(10) << (served ? waitSum / served : 0) << std::setw(10)
+                  << maxWait << std::setw(12) << report.specializations[0].wait.p99 << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file TriageBench.cpp
+ * @brief Measures TriageQueue against a binary heap at a million queued patients.
+ *
+ * Usage: hospital_triage_bench [patients] [levels]   (default: 1000000, 5)
+ *
+ * Queues every patient with a random triage level, then drains the queue, and checks that
+ * patients leave most urgent level first and in arrival order within a level. The baseline
+ * is a std::priority_queue ordered by (level, arrival number), the usual way to get a stable
+ * priority queue from a heap. A third run goes through HospitalQueue, which adds timestamps,
+ * depth gauges and the wait histogram, to show what the statistics cost. A last run calls only
+ * the QueueStats hooks, with precomputed waits, to split that cost from the clock reads.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "HospitalQueue.hpp"
+#include "QueueStats.hpp"
+#include "TriageQueue.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Arrival {
+    uint32_t arrival;
+    int level;
+    std::string name;
+};
+
+struct HeapEntry {
+    int level;
+    uint32_t arrival;
+    Arrival patient;
+
+    bool operator<(const HeapEntry& other) const {
+        // std::priority_queue pops the largest element: make it the most urgent, oldest one
+        if (level != other.level) return level > other.level;
+        return arrival > other.arrival;
+    }
+};
+
+double nanosPer(Clock::time_point start, size_t operations) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / operations;
+}
+
+/**
+ * @brief True if the drained order is most urgent level first, FIFO within a level.
+ */
+bool inTriageOrder(const std::vector<Arrival>& drained) {
+    for (size_t i = 1; i < drained.size(); ++i) {
+        const Arrival& a = drained[i - 1];
+        const Arrival& b = drained[i];
+        if (a.level > b.level || (a.level == b.level && a.arrival > b.arrival)) return false;
+    }
+    return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    long long count = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    int levels = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (count <= 0 || levels < 1 || levels > TriageQueue<Arrival>::MAX_LEVELS) {
+        std::cerr << "Usage: hospital_triage_bench [patients] [levels 1-64]\n";
+        return 1;
+    }
+    size_t n = static_cast<size_t>(count);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> level(0, levels - 1);
+    std::vector<Arrival> patients(n);
+    for (size_t i = 0; i < n; ++i) {
+        patients[i] = {static_cast<uint32_t>(i), level(rng), "patient " + std::to_string(i % 1000)};
+    }
+    std::vector<Arrival> drained;
+    drained.reserve(n);
+
+    std::cout << n << " patients, " << levels << " levels\n\n"
+              << std::left << std::setw(16) << "structure" << std::right << std::setw(14)
+              << "push ns/op" << std::setw(14) << "pop ns/op" << std::setw(10) << "order"
+              << "\n"
+              << std::fixed << std::setprecision(1);
+
+    {
+        TriageQueue<Arrival> queue(levels);
+        auto start = Clock::now();
+        for (const Arrival& p : patients) queue.push(p, p.level);
+        double push = nanosPer(start, n);
+        start = Clock::now();
+        while (std::optional<Arrival> p = queue.pop()) drained.push_back(std::move(*p));
+        double pop = nanosPer(start, n);
+        std::cout << std::left << std::setw(16) << "TriageQueue" << std::right << std::setw(14)
+                  << push << std::setw(14) << pop << std::setw(10)
+                  << (inTriageOrder(drained) && drained.size() == n ? "ok" : "WRONG") << "\n";
+    }
+
+    drained.clear();
+    {
+        std::priority_queue<HeapEntry> heap;
+        auto start = Clock::now();
+        for (const Arrival& p : patients) heap.push({p.level, p.arrival, p});
+        double push = nanosPer(start, n);
+        start = Clock::now();
+        while (!heap.empty()) {
+            drained.push_back(heap.top().patient);
+            heap.pop();
+        }
+        double pop = nanosPer(start, n);
+        std::cout << std::left << std::setw(16) << "binary heap" << std::right << std::setw(14)
+                  << push << std::setw(14) << pop << std::setw(10)
+                  << (inTriageOrder(drained) && drained.size() == n ? "ok" : "WRONG") << "\n";
+    }
+
+    drained.clear();
+    {
+        std::vector<Patient> named;
+        named.reserve(n);
+        for (const Arrival& p : patients) named.emplace_back(p.name, p.level + 1);
+        HospitalQueue queue(0, levels, TriageQueue<Patient>::UNBOUNDED);
+        auto start = Clock::now();
+        for (const Patient& p : named) queue.push(p);
+        double push = nanosPer(start, n);
+        start = Clock::now();
+        while (std::optional<Patient> p = queue.pop()) {
+            drained.push_back({static_cast<uint32_t>(drained.size()), p->level, ""});
+        }
+        double pop = nanosPer(start, n);
+        // Arrival numbers are lost on the way: check the levels and the recorded counts only
+        bool ordered = std::is_sorted(drained.begin(), drained.end(),
+                                      [](const Arrival& a, const Arrival& b) {
+                                          return a.level < b.level;
+                                      }) &&
+                       queue.statistics().called == n && queue.statistics().wait.count() == n;
+        std::cout << std::left << std::setw(16) << "+ statistics" << std::right << std::setw(14)
+                  << push << std::setw(14) << pop << std::setw(10)
+                  << (ordered && drained.size() == n ? "ok" : "WRONG") << "\n";
+    }
+
+    {
+        // Waits spread over the histogram like real ones, from microseconds to hours
+        std::vector<int64_t> waits(n);
+        for (size_t i = 0; i < n; ++i) waits[i] = int64_t{1000} << (patients[i].arrival % 42);
+        QueueStats stats;
+        auto start = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            stats.onPushStart();
+            stats.onPushed();
+        }
+        double push = nanosPer(start, n);
+        start = Clock::now();
+        for (int64_t wait : waits) stats.onPop(wait);
+        double pop = nanosPer(start, n);
+        bool counted = stats.admitted == n && stats.called == n && stats.wait.count() == n &&
+                       stats.depth == 0;
+        std::cout << std::left << std::setw(16) << "  hooks only" << std::right << std::setw(14)
+                  << push << std::setw(14) << pop << std::setw(10)
+                  << (counted ? "ok" : "WRONG") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file WalBench.cpp
+ * @brief Measures write-ahead log throughput with and without fsync batching.
+ *
+ * Usage: hospital_wal_bench [records per thread] [threads] [log file]
+ * (defaults: 2000, 8, wal_bench.wal in the current directory; the file is removed at the end)
+ *
+ * Every thread appends admission records as fast as it can, once per sync mode: no fsync at
+ * all, one fsync per record, and group commit, where threads waiting for the disk share one
+ * fsync. Each mode runs with a single thread and with all of them, and the log is then read
+ * back to check that every record arrived, in lsn order.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "WriteAheadLog.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+const char *modeName(WriteAheadLog::Sync sync) {
+    switch (sync) {
+        case WriteAheadLog::Sync::None:
+            return "no fsync";
+        case WriteAheadLog::Sync::EveryRecord:
+            return "fsync per record";
+        case WriteAheadLog::Sync::GroupCommit:
+            return "group commit";
+    }
+    return "";
+}
+
+/**
+ * @return True if the log holds every record.
+ */
+bool run(WriteAheadLog::Sync sync, int threads, long long perThread, const std::string &path) {
+    std::remove(path.c_str());
+    uint64_t syncs = 0;
+    double seconds = 0;
+    {
+        WriteAheadLog log(path, sync);
+        log.recover(0);
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&log, t, perThread] {
+                for (long long i = 0; i < perThread; ++i) {
+                    log.append(WriteAheadLog::Op::Admit, t, Patient("patient number", 1 + i % 5));
+                }
+            });
+        }
+        for (std::thread &worker : workers) worker.join();
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        syncs = log.syncCount();
+    }
+
+    uint64_t total = static_cast<uint64_t>(threads) * perThread;
+    std::vector<WriteAheadLog::Record> records = WriteAheadLog(path, sync).recover(0);
+    bool complete = records.size() == total && records.back().lsn == total;
+    std::cout << std::left << std::setw(18) << modeName(sync) << std::right << std::setw(8)
+              << threads << std::setw(14) << static_cast<long long>(total / seconds)
+              << std::setw(12) << syncs << std::setw(14) << std::setprecision(1)
+              << (syncs ? static_cast<double>(total) / syncs : 0.0) << std::setw(14)
+              << 1e6 * seconds * threads / total << std::setw(10) << (complete ? "ok" : "LOST")
+              << "\n";
+    return complete;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    long long perThread = argc > 1 ? std::atoll(argv[1]) : 2000;
+    int threads = argc > 2 ? std::atoi(argv[2]) : 8;
+    std::string path = argc > 3 ? argv[3] : "wal_bench.wal";
+    if (perThread < 1 || threads < 1) {
+        std::cerr << "Usage: hospital_wal_bench [records per thread] [threads] [log file]\n";
+        return 1;
+    }
+
+    std::cout << std::left << std::setw(18) << "mode" << std::right << std::setw(8) << "threads"
+              << std::setw(14) << "records/s" << std::setw(12) << "fsyncs" << std::setw(14)
+              << "records/fsync" << std::setw(14) << "us/append" << std::setw(10) << "log"
+              << "\n"
+              << std::fixed;
+    bool ok = true;
+    for (WriteAheadLog::Sync sync : {WriteAheadLog::Sync::None, WriteAheadLog::Sync::EveryRecord,
+                                     WriteAheadLog::Sync::GroupCommit}) {
+        ok = run(sync, 1, perThread, path) && ok;
+        if (threads > 1) ok = run(sync, threads, perThread, path) && ok;
+    }
+    std::remove(path.c_str());
+    return ok ? 0 : 1;
+}
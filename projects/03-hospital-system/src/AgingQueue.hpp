@@ -0,0 +1,115 @@
+/**
+ * @file AgingQueue.hpp
+ * @brief Triage queue where waiting raises a patient's priority, so nobody starves.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @class AgingQueue
+ * @brief Binary heap ordered by arrival time plus `level * step`.
+ *
+ * An item of level l queued at time t gets the key `t + l * step` once, at push time, and the
+ * smallest key leaves first: waiting one `step` is worth one level of urgency. So an item is
+ * served before any item of one level more urgent that arrived more than `step` after it, and
+ * no arrival more than `l * step` after it can overtake it, however urgent: a stream of urgent
+ * patients can no longer starve it. Keys never change, so push and pop are O(log n) without
+ * rescanning the queue. Equal keys leave in push order.
+ *
+ * @tparam T Item type.
+ * @tparam Time Arrival time type, e.g. nanoseconds or simulated hours.
+ */
+template <typename T, typename Time = int64_t>
+class AgingQueue {
+   public:
+    static constexpr size_t UNBOUNDED = 0;
+
+    /**
+     * @param levels Number of priority levels; 0 is the most urgent.
+     * @param step How much waiting time one level is worth; must be positive.
+     * @param capacity Maximum number of queued items, or UNBOUNDED.
+     */
+    AgingQueue(int levels, Time step, size_t capacity = UNBOUNDED)
+        : levelCount(levels), agingStep(step), maxItems(capacity) {
+        assert(levels >= 1);
+        assert(step > Time{});
+    }
+
+    /**
+     * @brief Queues an item that arrived at `arrival`.
+     * @return False if the queue is full.
+     */
+    bool push(T item, int level, Time arrival) {
+        assert(level >= 0 && level < levelCount);
+        if (full()) return false;
+        heap.push_back({arrival + static_cast<Time>(level) * agingStep, nextSequence++, level,
+                        std::move(item)});
+        std::push_heap(heap.begin(), heap.end(), after);
+        return true;
+    }
+
+    /**
+     * @brief Removes the item with the smallest key.
+     */
+    std::optional<T> pop() {
+        if (heap.empty()) return std::nullopt;
+        std::pop_heap(heap.begin(), heap.end(), after);
+        std::optional<T> item(std::move(heap.back().item));
+        heap.pop_back();
+        return item;
+    }
+
+    const T *peek() const { return heap.empty() ? nullptr : &heap.front().item; }
+
+    /**
+     * @brief Calls `visit(item, level)` on every item in pop order; O(n log n).
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        std::vector<const Entry *> order;
+        order.reserve(heap.size());
+        for (const Entry &entry : heap) order.push_back(&entry);
+        std::sort(order.begin(), order.end(),
+                  [](const Entry *a, const Entry *b) { return after(*b, *a); });
+        for (const Entry *entry : order) visit(entry->item, entry->level);
+    }
+
+    size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+    bool full() const { return maxItems != UNBOUNDED && heap.size() >= maxItems; }
+    int levels() const { return levelCount; }
+    size_t capacity() const { return maxItems; }
+    Time step() const { return agingStep; }
+
+    void clear() { heap.clear(); }
+
+   private:
+    struct Entry {
+        Time key;
+        uint64_t sequence;  ///< Push order, to break ties first come, first served
+        int level;
+        T item;
+    };
+
+    std::vector<Entry> heap;
+    int levelCount;
+    Time agingStep;
+    size_t maxItems;
+    uint64_t nextSequence{0};
+
+    /**
+     * @brief Heap order: true if `a` leaves after `b`, so the heap top leaves first.
+     */
+    static bool after(const Entry &a, const Entry &b) {
+        if (a.key != b.key) return b.key < a.key;
+        return a.sequence > b.sequence;
+    }
+};
@@ -0,0 +1,250 @@
+#include "BinaryDatabase.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "DatabaseFormat.hpp"
+#include "HospitalQueue.hpp"
+#include "WriteAheadLog.hpp"
+
+namespace BinaryDatabase {
+namespace {
+constexpr size_t MIN_PAYLOAD = 1 + sizeof(uint8_t) + 3;  ///< Smallest varint, level and name
+constexpr int MAX_VARINT = 5;                            ///< Bytes of a 32-bit varint
+
+using CrcTables = std::array<std::array<uint32_t, 256>, 8>;
+
+/**
+ * @brief Slicing-by-8 tables: tables[k][b] is the CRC of byte b followed by k zero bytes.
+ */
+const CrcTables &crcTables() {
+    static const CrcTables tables = [] {
+        CrcTables entries{};
+        for (uint32_t byte = 0; byte < 256; ++byte) {
+            uint32_t crc = byte;
+            for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0);
+            entries[0][byte] = crc;
+        }
+        for (size_t k = 1; k < entries.size(); ++k) {
+            for (uint32_t byte = 0; byte < 256; ++byte) {
+                uint32_t previous = entries[k - 1][byte];
+                entries[k][byte] = (previous >> 8) ^ entries[0][previous & 0xFF];
+            }
+        }
+        return entries;
+    }();
+    return tables;
+}
+
+void appendVarint(std::string &bytes, uint32_t value) {
+    for (; value >= 0x80; value >>= 7) {
+        bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    }
+    bytes.push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Reads a varint of at most MAX_VARINT bytes from [pos, end).
+ * @return Its size, or 0 if it does not end in time.
+ */
+size_t readVarint(const char *pos, const char *end, uint32_t &value) {
+    value = 0;
+    for (int i = 0; i < MAX_VARINT && pos + i < end; ++i) {
+        auto byte = static_cast<uint8_t>(pos[i]);
+        value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+        if (byte < 0x80) return i + 1;
+    }
+    return 0;
+}
+
+bool readFile(const std::string &path, std::string &bytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    bytes.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(&bytes[0], static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Decodes the record at `pos` if it is intact.
+ * @return Its total size, or 0 if it is damaged or cut short.
+ */
+size_t decodeRecord(const std::string &bytes, size_t pos, int &spec, Patient &p) {
+    RecordHeader header;
+    if (bytes.size() - pos < sizeof(header)) return 0;
+    std::memcpy(&header, bytes.data() + pos, sizeof(header));
+    if (header.mark != RECORD_MARK || header.length < MIN_PAYLOAD ||
+        bytes.size() - pos - sizeof(header) < header.length) {
+        return 0;
+    }
+    const char *payload = bytes.data() + pos + sizeof(header);
+    const char *end = payload + header.length;
+    uint32_t crc = crc32(&header.length, sizeof(header.length));
+    if (crc32(payload, header.length, crc) != header.crc) return 0;
+
+    uint32_t specId;
+    size_t varint = readVarint(payload, end, specId);
+    if (varint == 0 || specId >= static_cast<uint32_t>(DatabaseFormat::MAX_SPECIALIZATIONS) ||
+        end - payload < static_cast<std::ptrdiff_t>(varint + MIN_PAYLOAD - 1)) {
+        return 0;
+    }
+    auto level = static_cast<uint8_t>(payload[varint]);
+    if (level == 0) return 0;
+    spec = static_cast<int>(specId);
+    p.level = level;
+    p.name.assign(payload + varint + 1, end);
+    return Patient::isValidName(p.name) ? sizeof(header) + header.length : 0;
+}
+
+/**
+ * @brief The position of the next record mark after `pos`, or the end of the file.
+ */
+size_t nextMark(const std::string &bytes, size_t pos) {
+    char mark[sizeof(RECORD_MARK)];
+    std::memcpy(mark, &RECORD_MARK, sizeof(mark));
+    size_t next = bytes.find(std::string(mark, sizeof(mark)), pos + 1);
+    return next == std::string::npos ? bytes.size() : next;
+}
+}  // namespace
+
+uint32_t crc32(const void *data, size_t size, uint32_t crc) {
+    const CrcTables &t = crcTables();
+    auto bytes = static_cast<const unsigned char *>(data);
+    crc = ~crc;
+    for (; size >= 8; size -= 8, bytes += 8) {
+        crc ^= bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+        crc = t[7][crc & 0xFF] ^ t[6][crc >> 8 & 0xFF] ^ t[5][crc >> 16 & 0xFF] ^
+              t[4][crc >> 24] ^ t[3][bytes[4]] ^ t[2][bytes[5]] ^ t[1][bytes[6]] ^ t[0][bytes[7]];
+    }
+    for (; size > 0; --size, ++bytes) crc = t[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+Writer::Writer(uint64_t checkpointLsn) {
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.checkpointLsn = checkpointLsn;
+    bytes.append(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+void Writer::add(int spec, const Patient &p) {
+    // The payload goes straight after a placeholder header, which is filled in once it is known
+    size_t start = bytes.size();
+    bytes.append(sizeof(RecordHeader), '\0');
+    appendVarint(bytes, static_cast<uint32_t>(spec));
+    bytes.push_back(static_cast<char>(p.level));
+    bytes.append(p.name, 0, MAX_NAME);
+
+    RecordHeader header{RECORD_MARK, static_cast<uint16_t>(bytes.size() - start - sizeof(header)),
+                        0};
+    header.crc = crc32(&header.length, sizeof(header.length));
+    header.crc = crc32(bytes.data() + start + sizeof(header), header.length, header.crc);
+    std::memcpy(&bytes[start], &header, sizeof(header));
+    ++count;
+}
+
+bool read(const std::string &path, const std::function<void(int spec, Patient p)> &visit,
+          ReadResult &result, std::string &error) {
+    result = ReadResult{};
+    std::string bytes;
+    if (!readFile(path, bytes)) {
+        error = "cannot read " + path;
+        return false;
+    }
+    Header header;
+    if (bytes.size() < sizeof(header)) {
+        error = "file too small for a database header";
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "not a hospital database";
+        return false;
+    }
+    if (header.version != VERSION) {
+        error = "unsupported database version";
+        return false;
+    }
+    result.checkpointLsn = header.checkpointLsn;
+
+    int spec = 0;
+    Patient p;
+    size_t pos = sizeof(header);
+    while (pos < bytes.size()) {
+        if (size_t size = decodeRecord(bytes, pos, spec, p)) {
+            visit(spec, std::move(p));
+            ++result.records;
+            pos += size;
+            continue;
+        }
+        size_t next = nextMark(bytes, pos);
+        ++result.damaged;
+        result.damagedBytes += next - pos;
+        pos = next;
+    }
+    return true;
+}
+
+bool convertTextToBinary(const std::string &textPath, const std::string &binaryPath,
+                         int levels, std::string &error) {
+    std::ifstream in(textPath);
+    if (!in) {
+        error = "cannot open " + textPath;
+        return false;
+    }
+    const std::string tag = DatabaseFormat::CHECKPOINT_TAG;
+    uint64_t checkpointLsn = 0;
+    std::vector<std::string> lines;
+    std::string line;
+    while (getline(in, line)) {
+        if (line.compare(0, tag.size(), tag) == 0) {
+            checkpointLsn = std::strtoull(line.c_str() + tag.size(), nullptr, 10);
+        } else if (!line.empty()) {
+            lines.push_back(std::move(line));
+        }
+    }
+    Writer writer(checkpointLsn);
+    for (const std::string &queueLine : lines) {
+        // Plain triage queue: forEach() returns the patients in file order
+        HospitalQueue queue(queueLine, levels, TriageQueue<Patient>::UNBOUNDED);
+        if (queue.id < 0 || queue.id >= DatabaseFormat::MAX_SPECIALIZATIONS) continue;
+        queue.forEach([&](const Patient &p) { writer.add(queue.id, p); });
+    }
+    if (!durableReplace(binaryPath, writer.contents())) {
+        error = "cannot write " + binaryPath;
+        return false;
+    }
+    return true;
+}
+
+bool convertBinaryToText(const std::string &binaryPath, const std::string &textPath,
+                         ReadResult &result, std::string &error) {
+    std::vector<std::vector<Patient>> queues;
+    auto collect = [&queues](int spec, Patient p) {
+        if (queues.size() <= static_cast<size_t>(spec)) queues.resize(spec + 1);
+        queues[spec].push_back(std::move(p));
+    };
+    if (!read(binaryPath, collect, result, error)) return false;
+
+    std::ostringstream text;
+    text << DatabaseFormat::CHECKPOINT_TAG << result.checkpointLsn << "\n";
+    for (size_t spec = 0; spec < queues.size(); ++spec) {
+        if (queues[spec].empty()) continue;
+        text << spec << HospitalQueue::DELIM;
+        for (const Patient &p : queues[spec]) text << p.toString() << HospitalQueue::DELIM;
+        text << "\n";
+    }
+    if (!durableReplace(textPath, text.str())) {
+        error = "cannot write " + textPath;
+        return false;
+    }
+    return true;
+}
+}  // namespace BinaryDatabase
@@ -0,0 +1,122 @@
+/**
+ * @file BinaryDatabase.hpp
+ * @brief Checksummed binary format of the waiting patients, an alternative to patients.txt.
+ *
+ * File layout (native byte order):
+ *
+ *     Header                      24 bytes: magic, version, checkpoint lsn
+ *     Record...                   one per waiting patient, in call order per specialization
+ *
+ * and every record is
+ *
+ *     uint16 mark                 RECORD_MARK, to find the next record after a bad one
+ *     uint16 length               of the payload
+ *     uint32 crc                  CRC-32 of the length and the payload
+ *     payload                     the specialization as a varint (7 bits a byte, low bits
+ *                                 first), the uint8 level, then the name
+ *
+ * Ten bytes besides the name for the first 128 specializations. Loading checks each record in
+ * one pass, with no text parsing. A record whose mark, length, checksum or contents are wrong
+ * is skipped by searching for the next mark, so corruption costs the records it touches and
+ * nothing else, and a torn tail costs only the last record.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "Patient.hpp"
+
+namespace BinaryDatabase {
+constexpr char MAGIC[8] = {'H', 'O', 'S', 'P', 'Q', 'U', 'E', '\0'};
+constexpr uint32_t VERSION = 1;
+/// Bytes 0xE1 0x9D on little-endian machines: neither is a name character
+constexpr uint16_t RECORD_MARK = 0x9DE1;
+constexpr size_t MAX_NAME = UINT16_MAX - 16;  ///< Leaves room for the rest of the payload
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t checkpointLsn;  ///< As the text file's checkpoint tag
+};
+
+struct RecordHeader {
+    uint16_t mark;
+    uint16_t length;
+    uint32_t crc;
+};
+
+static_assert(sizeof(Header) == 24, "unexpected database header layout");
+static_assert(sizeof(RecordHeader) == 8, "unexpected database record layout");
+
+/**
+ * @brief CRC-32 (the zlib/PNG polynomial), continuing from `crc`, eight bytes at a time.
+ */
+uint32_t crc32(const void *data, size_t size, uint32_t crc = 0);
+
+/**
+ * @class Writer
+ * @brief Builds a database file in memory, to be written in one go (see durableReplace()).
+ */
+class Writer {
+   public:
+    explicit Writer(uint64_t checkpointLsn);
+
+    /**
+     * @brief Appends a patient; a specialization's patients go in call order.
+     *
+     * Names longer than MAX_NAME are cut short.
+     */
+    void add(int spec, const Patient &p);
+
+    const std::string &contents() const { return bytes; }
+    size_t records() const { return count; }
+
+   private:
+    std::string bytes;
+    size_t count{0};
+};
+
+/**
+ * @struct ReadResult
+ * @brief What read() found.
+ */
+struct ReadResult {
+    uint64_t checkpointLsn{0};
+    size_t records{0};       ///< Valid records, all passed to the visitor
+    size_t damaged{0};       ///< Corrupted stretches skipped, each one or more records
+    size_t damagedBytes{0};  ///< Bytes skipped
+};
+
+/**
+ * @brief Reads a database file and passes every valid record, in file order, to `visit`.
+ *
+ * A record of a specialization at or above DatabaseFormat::MAX_SPECIALIZATIONS counts as
+ * damaged, so `visit` never sees an id that could not be sized for.
+ * @param error Receives the reason on failure.
+ * @return False if the file cannot be read or is not a database of this version; damaged
+ * records alone are skipped and counted, not a failure.
+ */
+bool read(const std::string &path, const std::function<void(int spec, Patient p)> &visit,
+          ReadResult &result, std::string &error);
+
+/**
+ * @brief Converts a text database (`patients.txt`) to the binary format.
+ * @param levels Triage levels, for reading files of the two-priority version.
+ * @param error Receives the reason on failure.
+ */
+bool convertTextToBinary(const std::string &textPath, const std::string &binaryPath,
+                         int levels, std::string &error);
+
+/**
+ * @brief Converts a binary database back to the text format, skipping damaged records.
+ * @param result Receives what was read.
+ * @param error Receives the reason on failure.
+ */
+bool convertBinaryToText(const std::string &binaryPath, const std::string &textPath,
+                         ReadResult &result, std::string &error);
+}  // namespace BinaryDatabase
@@ -0,0 +1,346 @@
+/**
+ * @file ConcurrentTriageQueue.hpp
+ * @brief Lock-free multi-level priority queue for many producer and consumer threads.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @class MpmcRing
+ * @brief Bounded multi-producer/multi-consumer FIFO (Dmitry Vyukov's array queue).
+ *
+ * Every cell carries a sequence number that says whose turn it is: a producer may fill cell
+ * `pos` when its sequence equals `pos`, a consumer may empty it when it equals `pos + 1`.
+ * Producers and consumers each claim a position with one compare-and-swap on their own
+ * counter, so push and pop take no locks, and a thread never waits for another one unless
+ * they hit the very same cell.
+ *
+ * close() stops all further pushes for good, while pops go on until drained() says the ring
+ * is empty and will stay so.
+ */
+template <typename T>
+class MpmcRing {
+   public:
+    /**
+     * @param capacity Number of cells, rounded up to a power of two (at least 2).
+     */
+    explicit MpmcRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcRing(const MpmcRing &) = delete;
+    MpmcRing &operator=(const MpmcRing &) = delete;
+
+    /**
+     * @param item Moved from only if the push succeeds.
+     * @return False if the ring is full or closed.
+     */
+    bool push(T &&item) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            if (pos & CLOSED) return false;
+            Cell &cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(item);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // the consumers have not freed this cell yet: full
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @return False if the ring is empty.
+     */
+    bool pop(T &item) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = std::move(cell.value);
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // no producer has filled this cell yet: empty
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Makes every later push() fail. A push that already claimed a cell still fills it.
+     */
+    void close() { enqueuePos.fetch_or(CLOSED); }
+
+    /**
+     * @brief True once the ring is closed and every claimed cell has been popped.
+     */
+    bool drained() const {
+        size_t end = enqueuePos.load(std::memory_order_acquire);
+        return (end & CLOSED) && dequeuePos.load(std::memory_order_acquire) == (end & ~CLOSED);
+    }
+
+    /**
+     * @brief Calls `visit(item)` on every item, oldest first. Only while no thread pushes or
+     * pops.
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        size_t end = enqueuePos.load(std::memory_order_acquire) & ~CLOSED;
+        for (size_t pos = dequeuePos.load(std::memory_order_acquire); pos != end; ++pos) {
+            visit(cells[pos & mask].value);
+        }
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    /**
+     * @brief The number of items; only exact while no thread pushes or pops.
+     */
+    size_t size() const {
+        return (enqueuePos.load(std::memory_order_acquire) & ~CLOSED) -
+               dequeuePos.load(std::memory_order_acquire);
+    }
+
+   private:
+    /// Set in enqueuePos by close(); positions never get near it
+    static constexpr size_t CLOSED = size_t{1} << (std::numeric_limits<size_t>::digits - 1);
+
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask{0};
+    // Separate cache lines, so producers and consumers do not invalidate each other's counter
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+};
+
+/**
+ * @class ConcurrentTriageQueue
+ * @brief Thread-safe counterpart of TriageQueue: one unbounded FIFO of MpmcRing segments per
+ * level.
+ *
+ * pop() tries the levels from the most urgent one down and takes the first item it finds, so
+ * a patient is not called while a more urgent one has been waiting since before the call
+ * began. The one exception is a race: a push still in progress on a more urgent level hides
+ * the items behind it for that instant. Items of one level leave in the order their push()
+ * calls took effect. A total count alone enforces the capacity: every level starts with one
+ * segment of DEFAULT_LEVEL_CAPACITY items and links more as it fills.
+ */
+template <typename T>
+class ConcurrentTriageQueue {
+   public:
+    static constexpr size_t UNBOUNDED = 0;
+    static constexpr size_t DEFAULT_LEVEL_CAPACITY = 1024;
+
+    /**
+     * @param levels Number of priority levels.
+     * @param capacity Maximum number of queued items, or UNBOUNDED.
+     */
+    explicit ConcurrentTriageQueue(int levels, size_t capacity = UNBOUNDED) : maxItems(capacity) {
+        assert(levels >= 1);
+        for (int level = 0; level < levels; ++level) {
+            queues.push_back(std::make_unique<Level>(*this));
+        }
+    }
+
+    /**
+     * @brief Queues an item at a level, 0 being the most urgent.
+     * @return False if the queue is at its capacity.
+     */
+    bool push(T item, int level) {
+        assert(level >= 0 && level < levels());
+        // Reserve a slot first, so concurrent pushes can never overshoot the capacity
+        size_t reserved = count.fetch_add(1, std::memory_order_relaxed);
+        if (maxItems != UNBOUNDED && reserved >= maxItems) {
+            count.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        Active active(*this);
+        queues[level]->push(std::move(item));
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item of the most urgent non-empty level.
+     */
+    std::optional<T> pop() {
+        T item;
+        Active active(*this);
+        for (auto &queue : queues) {
+            if (queue->pop(item)) {
+                count.fetch_sub(1, std::memory_order_relaxed);
+                return item;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Calls `visit(item, level)` on every item in pop order. Only while no thread
+     * pushes or pops.
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (int level = 0; level < levels(); ++level) {
+            queues[level]->forEach([&](const T &item) { visit(item, level); });
+        }
+    }
+
+    /**
+     * @brief The number of queued items; only a snapshot while other threads are active.
+     */
+    size_t size() const {
+        auto items = static_cast<std::ptrdiff_t>(count.load(std::memory_order_relaxed));
+        return items > 0 ? static_cast<size_t>(items) : 0;
+    }
+    bool empty() const { return size() == 0; }
+    int levels() const { return static_cast<int>(queues.size()); }
+
+   private:
+    /**
+     * @brief Counts a running push or pop for as long as it may hold a segment pointer.
+     */
+    class Active {
+        ConcurrentTriageQueue &queue;
+
+       public:
+        explicit Active(ConcurrentTriageQueue &queue) : queue(queue) { ++queue.active; }
+        ~Active() { --queue.active; }
+        Active(const Active &) = delete;
+        Active &operator=(const Active &) = delete;
+    };
+
+    /**
+     * @class Level
+     * @brief Unbounded FIFO of one level: a linked list of MpmcRing segments.
+     *
+     * Producers push into the tail segment. When it is full, the first producer to notice
+     * links a new segment behind it and closes it, so no item can land in a segment behind
+     * items of its successor. Consumers pop from the head segment and move the head on once
+     * it is drained. Only freeing a drained segment takes a lock.
+     *
+     * push() and pop() must run inside an Active scope of the owning queue.
+     */
+    class Level {
+       public:
+        explicit Level(ConcurrentTriageQueue &owner)
+            : owner(owner), head(new Segment()), tail(head.load()) {}
+
+        ~Level() {
+            for (Segment *segment = head.load(); segment != nullptr;) {
+                Segment *next = segment->next.load();
+                delete segment;
+                segment = next;
+            }
+        }
+
+        Level(const Level &) = delete;
+        Level &operator=(const Level &) = delete;
+
+        void push(T item) {
+            for (;;) {
+                Segment *segment = tail.load();
+                if (segment->ring.push(std::move(item))) return;
+                // Full, or closed by another producer: give it a successor, then close it
+                Segment *next = segment->next.load();
+                if (next == nullptr) {
+                    auto fresh = std::make_unique<Segment>();
+                    if (segment->next.compare_exchange_strong(next, fresh.get())) {
+                        next = fresh.release();
+                    }
+                }
+                segment->ring.close();
+                tail.compare_exchange_strong(segment, next);
+            }
+        }
+
+        /**
+         * @return False if the level is empty, or a push in progress hides its items.
+         */
+        bool pop(T &item) {
+            for (;;) {
+                Segment *segment = head.load();
+                if (segment->ring.pop(item)) return true;
+                if (!segment->ring.drained()) return false;
+                // A closed segment always has a successor. Move the tail past it before the
+                // head, so that neither pointer leads to it once it is retired.
+                Segment *next = segment->next.load();
+                Segment *expected = segment;
+                tail.compare_exchange_strong(expected, next);
+                expected = segment;
+                if (head.compare_exchange_strong(expected, next)) retire(segment);
+            }
+        }
+
+        template <typename Visitor>
+        void forEach(Visitor visit) const {
+            for (Segment *segment = head.load(); segment != nullptr;
+                 segment = segment->next.load()) {
+                segment->ring.forEach(visit);
+            }
+        }
+
+       private:
+        struct Segment {
+            MpmcRing<T> ring{DEFAULT_LEVEL_CAPACITY};
+            std::atomic<Segment *> next{nullptr};
+        };
+
+        /**
+         * @brief Frees a segment the head and tail have moved past, once nobody else can
+         * hold it.
+         *
+         * A thread that read the head or tail before they moved may still use the segment.
+         * Every push and pop counts itself in `active` before it reads a pointer, and all of
+         * these operations are sequentially consistent: if the caller is the only one counted,
+         * every other thread will read the pointers after they moved. Otherwise the segment
+         * waits on the retired list for a later retire() or the destructor.
+         */
+        void retire(Segment *segment) {
+            std::lock_guard<std::mutex> lock(retiredLock);
+            retired.emplace_back(segment);
+            if (owner.active.load() == 1) retired.clear();
+        }
+
+        ConcurrentTriageQueue &owner;
+        alignas(64) std::atomic<Segment *> head;
+        alignas(64) std::atomic<Segment *> tail;
+        std::mutex retiredLock;
+        std::vector<std::unique_ptr<Segment>> retired;
+    };
+
+    std::vector<std::unique_ptr<Level>> queues;
+    std::atomic<size_t> count{0};
+    alignas(64) std::atomic<int> active{0};  ///< Pushes and pops running now
+    size_t maxItems;
+};
@@ -0,0 +1,13 @@
+/**
+ * @file DatabaseFormat.hpp
+ * @brief Constants shared by the text and the binary patient databases.
+ */
+
+#pragma once
+
+namespace DatabaseFormat {
+/// First line of patients.txt, followed by the lsn of the last log record it contains
+constexpr const char *CHECKPOINT_TAG = "#checkpoint ";
+/// Specialization ids at or above this are corruption, not data
+constexpr int MAX_SPECIALIZATIONS = 1000;
+}  // namespace DatabaseFormat
@@ -0,0 +1,91 @@
+#include "HospitalQueue.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+HospitalQueue::HospitalQueue(int id, int levels, size_t capacity, bool concurrent,
+                             int64_t agingStep)
+    : id(id),
+      patients(concurrent || agingStep > 0 ? 1 : levels, capacity),
+      queueCapacity(capacity) {
+    if (concurrent) {
+        shared = std::make_unique<ConcurrentTriageQueue<Patient>>(levels, capacity);
+    } else if (agingStep > 0) {
+        aging = std::make_unique<AgingQueue<Patient>>(levels, agingStep, capacity);
+    }
+}
+
+HospitalQueue::HospitalQueue(const std::string &str, int levels, size_t capacity,
+                             bool concurrent, int64_t agingStep)
+    : HospitalQueue(-1, levels, capacity, concurrent, agingStep) {
+    std::string part;
+    std::istringstream iss(str);
+
+    // Read specialization ID
+    if (getline(iss, part, DELIM)) {
+        try {
+            id = std::stoi(part);  // Use std::stoi for safe conversion
+        } catch (const std::exception &e) {
+            std::cerr << "Warning: Corrupted queue data in file. Invalid ID: " << part
+                      << std::endl;
+            id = -1;  // Set to an invalid state
+            return;   // Stop parsing this corrupted line
+        }
+    }
+
+    // Read patients, stored in pop order
+    while (getline(iss, part, DELIM)) {
+        if (part.empty()) continue;  // Avoid creating patients from empty parts
+        if (!push(Patient::parse(part, levels))) {
+            ++dropped;
+            std::cerr << "Warning: Specialization " << id + 1
+                      << " is full, dropping patient: " << part << std::endl;
+        }
+    }
+}
+
+bool HospitalQueue::push(Patient p) {
+    if (p.enqueuedAt == 0) p.enqueuedAt = Patient::now();
+    p.dequeuedAt = 0;
+    int level = p.level - 1;
+    int64_t arrival = p.enqueuedAt;
+    stats->onPushStart();
+    bool pushed = shared  ? shared->push(std::move(p), level)
+                  : aging ? aging->push(std::move(p), level, arrival)
+                          : patients.push(std::move(p), level);
+    if (pushed) {
+        stats->onPushed();
+        return true;
+    }
+    stats->onRejected();
+    return false;
+}
+
+std::optional<Patient> HospitalQueue::pop() {
+    std::optional<Patient> p = shared ? shared->pop() : aging ? aging->pop() : patients.pop();
+    if (p) {
+        p->dequeuedAt = Patient::now();
+        stats->onPop(p->dequeuedAt - p->enqueuedAt);
+    }
+    return p;
+}
+
+size_t HospitalQueue::size() const {
+    return shared ? shared->size() : aging ? aging->size() : patients.size();
+}
+
+std::string HospitalQueue::toString() const {
+    std::ostringstream oss;
+    oss << id << DELIM;
+    forEach([&oss](const Patient &p) { oss << p.toString() << DELIM; });
+    return oss.str();
+}
+
+void HospitalQueue::print() const {
+    if (isEmpty()) {
+        return;
+    }
+    std::cout << "There are " << size() << " in specialization " << id + 1 << ": \n";
+    forEach([](const Patient &p) { p.print(); });
+}
@@ -0,0 +1,102 @@
+/**
+ * @file HospitalQueue.hpp
+ * @brief The triage queue of patients waiting for one specialization.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "AgingQueue.hpp"
+#include "ConcurrentTriageQueue.hpp"
+#include "Patient.hpp"
+#include "QueueStats.hpp"
+#include "TriageQueue.hpp"
+
+/**
+ * @brief Manages the triage queue of patients for a specific specialization.
+ *
+ * A concurrent queue keeps its patients in a ConcurrentTriageQueue, so push() and pop() may
+ * be called from any number of threads at once; toString(), print() and size() still need
+ * the queue to be quiet.
+ *
+ * An aging queue keeps its patients in an AgingQueue instead: every `agingStep` nanoseconds of
+ * waiting count as one level more urgent, so less urgent patients cannot starve.
+ *
+ * push() and pop() stamp the patient's timestamps and update the queue's QueueStats.
+ */
+class HospitalQueue {
+   public:
+    static constexpr char DELIM = '|';
+    int id{-1};
+
+    /**
+     * @param agingStep Nanoseconds of waiting worth one level, 0 for strict triage order.
+     * Ignored by concurrent queues.
+     */
+    HospitalQueue(int id, int levels, size_t capacity, bool concurrent = false,
+                  int64_t agingStep = 0);
+
+    /**
+     * @brief Deserializes a queue from a file string.
+     */
+    HospitalQueue(const std::string &str, int levels, size_t capacity, bool concurrent = false,
+                  int64_t agingStep = 0);
+
+    /**
+     * @brief Adds a patient behind every patient of the same or a more urgent level.
+     * @param p The patient to add; stamped with the current time unless already queued once.
+     * @return true if added successfully, false if queue is full.
+     */
+    bool push(Patient p);
+
+    /**
+     * @brief Removes and returns the next patient: the longest waiting of the most urgent
+     * level.
+     */
+    std::optional<Patient> pop();
+
+    size_t size() const;
+    bool isEmpty() const { return size() == 0; }
+    bool isConcurrent() const { return shared != nullptr; }
+    size_t capacity() const { return queueCapacity; }
+    const QueueStats &statistics() const { return *stats; }
+    QueueStats &statistics() { return *stats; }
+
+    /**
+     * @brief Patients the string constructor could not queue, for lack of capacity.
+     */
+    size_t droppedOnLoad() const { return dropped; }
+
+    /**
+     * @brief Restarts the counters and histogram; the depth gauge keeps the current depth.
+     */
+    void resetStatistics() { stats->reset(); }
+    std::string toString() const;
+    void print() const;
+
+    /**
+     * @brief Calls `visit(patient)` in pop order on whichever queue is in use. Only while no
+     * other thread pushes or pops.
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        if (shared) {
+            shared->forEach([&](const Patient &p, int) { visit(p); });
+        } else if (aging) {
+            aging->forEach([&](const Patient &p, int) { visit(p); });
+        } else {
+            patients.forEach([&](const Patient &p, int) { visit(p); });
+        }
+    }
+
+   private:
+    TriageQueue<Patient> patients;
+    std::unique_ptr<ConcurrentTriageQueue<Patient>> shared;  ///< Set in concurrent mode
+    std::unique_ptr<AgingQueue<Patient>> aging;              ///< Set in aging mode
+    std::unique_ptr<QueueStats> stats = std::make_unique<QueueStats>();
+    size_t queueCapacity;
+    size_t dropped{0};
+};
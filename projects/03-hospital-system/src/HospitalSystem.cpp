@@ -1,12 +1,19 @@
+#include "HospitalSystem.hpp"
+
 #include <Sefn/InputUtils.hpp>
+#include <algorithm>
 #include <cassert>
 #include <deque>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <limits>
 #include <sstream>
-#include <vector>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "BinaryDatabase.hpp"
 
 namespace {
 const std::string WHITESPACE = " \n\r\t\f\v";
@@ -35,275 +42,482 @@ void trim(std::string &s) {
 }
 }  // namespace
 
-/**
- * @brief Main system class for managing hospital operations.
- *
- * Handles patient intake, queue management for different specializations,
- * and data persistence.
- */
-class HospitalSystem {
-    const int MAX_SPEC = 20;
-
-    /**
-     * @brief Represents a single patient record.
-     */
-    struct Patient {
-        bool status{false};  ///< false for regular, true for urgent
-        std::string name;
-
-        Patient(std::string name, bool status) : status(status), name(name) {}
-        Patient() = default;
-
-        /**
-         * @brief Deserializes a patient from a string.
-         * @param str Formatted string from the database file.
-         */
-        Patient(std::string str) {
-            if (str.length() < 2 || !isValidName(str.substr(1))) {
-                // Handle the error gracefully. For now, let's create an invalid patient.
-                name = "INVALID_DATA";
-                status = false;
-                std::cerr << "Warning: Corrupted patient data found in file: " << str << std::endl;
-            } else {
-                status = (str[0] == '1');
-                name = str.substr(1);
-            }
-        }
-        std::string toString() const {
-            std::ostringstream oss;
-            oss << status << name;
-            return oss.str();
-        }
-        void print() const {
-            std::cout << "\t" << std::left << std::setw(25) << name;
-            std::cout << (status ? "\turgent\n" : "\tregular\n");
+HospitalSystem::HospitalSystem(int specializations, int levels, size_t capacity,
+                               bool concurrent, WriteAheadLog::Sync durability,
+                               double agingMinutes)
+    : specializationCount(specializations),
+      levelCount(levels),
+      queueCapacity(capacity),
+      concurrent(concurrent),
+      durability(durability),
+      agingStep(static_cast<int64_t>(agingMinutes * 60e9)),
+      index(levels, agingStep) {
+    assert(specializations >= 1);
+    assert(levels >= 1 && levels <= TriageQueue<Patient>::MAX_LEVELS);
+    assert(agingMinutes >= 0 && !(concurrent && agingMinutes > 0));
+    resetSpecializations();
+}
+
+std::string HospitalSystem::readName() {
+    std::string ret;
+    std::cout << "\tEnter name: ";
+    getline(std::cin, ret);
+    trim(ret);
+    while (!Patient::isValidName(ret)) {
+        std::cout << "\tInvlid name. Try again: ";
+        getline(std::cin, ret);
+        trim(ret);
+    }
+    return ret;
+}
+
+int HospitalSystem::readInRange(const std::string &prompt, int indentTabs, int start, int end) {
+    std::string errorMessage =
+        "Value must be between " + std::to_string(start) + " and " + std::to_string(end) + ".\n";
+    return Sefn::readValidatedInput<int>(
+        prompt, indentTabs, [start, end](int r) { return r >= start && r <= end; }, errorMessage);
+}
+
+int HospitalSystem::readSpecialization() {
+    std::string prompt = "Enter specialization[1 - " + std::to_string(specializationCount) + "]: ";
+    static const int indentTabs = 1;
+    return readInRange(prompt, indentTabs, 1, specializationCount) - 1;
+}
+
+int HospitalSystem::readLevel() const {
+    std::string prompt = "Enter triage level(1 = most urgent - " + std::to_string(levelCount) +
+                         " = least urgent): ";
+    return readInRange(prompt, 1, 1, levelCount);
+}
+
+bool HospitalSystem::admit(int spec, const Patient &p) {
+    assert(spec >= 0 && spec < specializationCount);
+    Patient queued = p;
+    if (queued.enqueuedAt == 0) queued.enqueuedAt = Patient::now();  // the index needs it too
+    if (!specializations[spec].push(queued)) return false;
+    {
+        std::lock_guard<std::mutex> lock(indexLock);
+        index.add(spec, queued);
+    }
+    if (wal) wal->append(WriteAheadLog::Op::Admit, spec, p);
+    return true;
+}
+
+std::optional<Patient> HospitalSystem::callNext(int spec, int *from) {
+    assert(spec >= 0 && spec < specializationCount);
+    int origin = spec;
+    std::optional<Patient> p = specializations[spec].pop();
+    if (!p) p = steal(spec, origin);
+    if (p) {
+        std::lock_guard<std::mutex> lock(indexLock);
+        index.remove(origin, *p);
+    }
+    // Logged against the queue the patient left, which is what replay needs
+    if (p && wal) wal->append(WriteAheadLog::Op::Call, origin, *p);
+    if (from) *from = origin;
+    return p;
+}
+
+std::optional<Patient> HospitalSystem::steal(int spec, int &from) {
+    if (static_cast<size_t>(spec) >= siblings.size()) return std::nullopt;
+    std::vector<int> candidates = siblings[spec];
+    while (!candidates.empty()) {
+        auto busiest =
+            std::max_element(candidates.begin(), candidates.end(), [this](int a, int b) {
+                return specializations[a].size() < specializations[b].size();
+            });
+        // Another doctor may empty it between size() and pop(): then try the next one
+        if (std::optional<Patient> p = specializations[*busiest].pop()) {
+            from = *busiest;
+            ++specializations[spec].statistics().stealsIn;
+            ++specializations[*busiest].statistics().stealsOut;
+            return p;
         }
-    };
+        candidates.erase(busiest);
+    }
+    return std::nullopt;
+}
 
-    /**
-     * @brief Manages a queue of patients for a specific specialization.
-     */
-    struct HospitalQueue {
-        int id{-1};
-        const char DELIM = '|';
-        const int MAX_QUEUE = 5;
-        std::deque<Patient> patients;
-
-        /**
-         * @brief Adds a patient to the queue.
-         * @param p The patient to add.
-         * @return true if added successfully, false if queue is full.
-         */
-        bool push(Patient &p) {
-            if ((int)patients.size() >= MAX_QUEUE) {
-                return false;
+std::vector<std::vector<int>> HospitalSystem::parseGroups(const std::string &text) {
+    std::vector<std::vector<int>> groups;
+    std::istringstream iss(text);
+    std::string group;
+    while (getline(iss, group, ',')) {
+        std::vector<int> members;
+        std::istringstream groupStream(group);
+        std::string member;
+        while (getline(groupStream, member, '+')) {
+            size_t dash = member.find('-', 1);
+            int first = 0, last = 0;
+            try {
+                size_t used = 0;
+                first = last = std::stoi(member, &used);
+                if (dash != std::string::npos) {
+                    if (used != dash) throw std::invalid_argument(member);
+                    last = std::stoi(member.substr(dash + 1), &used);
+                    used += dash + 1;
+                }
+                if (used != member.size()) throw std::invalid_argument(member);
+            } catch (const std::exception &) {
+                throw std::invalid_argument("Invalid specialization group: " + group);
             }
-            if (p.status) {
-                patients.push_front(p);
-            } else {
-                patients.push_back(p);
+            if (first < 1 || last < first) {
+                throw std::invalid_argument("Invalid specialization group: " + group);
             }
-            return true;
+            for (int id = first; id <= last; ++id) members.push_back(id - 1);
         }
+        if (members.empty()) throw std::invalid_argument("Empty specialization group in " + text);
+        groups.push_back(std::move(members));
+    }
+    return groups;
+}
 
-        /**
-         * @brief Removes and returns the next patient.
-         * @return A pair containing success status and the patient object.
-         */
-        std::pair<bool, Patient> pop() {
-            Patient ret = Patient();
-            if (patients.empty()) {
-                return {false, ret};
-            } else {
-                ret = patients.front();
-                patients.pop_front();
-                return {true, ret};
-            }
-        }
-        void operator=(const HospitalQueue &other) {
-            id = other.id;
-            patients = other.patients;
-        }
-        HospitalQueue(int id = -1) : id(id) {}
-
-        /**
-         * @brief Deserializes a queue from a file string.
-         */
-        HospitalQueue(std::string str) {
-            std::string part;
-            std::istringstream iss(str);
-
-            // Read specialization ID
-            if (getline(iss, part, DELIM)) {
-                try {
-                    id = std::stoi(part);  // Use std::stoi for safe conversion
-                } catch (const std::exception &e) {
-                    std::cerr << "Warning: Corrupted queue data in file. Invalid ID: " << part
-                              << std::endl;
-                    id = -1;  // Set to an invalid state
-                    return;   // Stop parsing this corrupted line
-                }
+void HospitalSystem::setGroups(const std::vector<std::vector<int>> &groups) {
+    std::vector<std::vector<int>> grouped(specializationCount);
+    std::vector<bool> seen(specializationCount, false);
+    for (const std::vector<int> &group : groups) {
+        for (int spec : group) {
+            if (spec < 0 || spec >= specializationCount) {
+                throw std::invalid_argument("No specialization " + std::to_string(spec + 1));
             }
-
-            // Read patients
-            while (getline(iss, part, DELIM)) {
-                if (!part.empty())  // Avoid creating patients from empty parts
-                    patients.push_back(Patient(part));
+            if (seen[spec]) {
+                throw std::invalid_argument("Specialization " + std::to_string(spec + 1) +
+                                            " is in more than one group");
             }
+            seen[spec] = true;
         }
-        bool isEmpty() const { return patients.empty(); }
-        std::string toString() const {
-            std::ostringstream oss;
-            oss << id << DELIM;
-            for (auto &p : patients) {
-                oss << p.toString() << DELIM;
+        for (int spec : group) {
+            for (int sibling : group) {
+                if (sibling != spec) grouped[spec].push_back(sibling);
             }
-            return oss.str();
         }
-        void print() const {
-            if (patients.empty()) {
-                return;
-            }
-            std::cout << "There are " << patients.size() << " in specialization " << id + 1
-                      << ": \n";
-            for (auto &p : patients) {
-                p.print();
-            }
+    }
+    siblings = std::move(grouped);
+}
+
+void HospitalSystem::addPatient() {
+    int spec = readSpecialization();
+    std::string name = readName();
+    Patient p = Patient(name, readLevel());
+    if (!admit(spec, p)) {
+        std::cout << "Sorry, we cannot add anymore patients at this specialization\n";
+    }
+}
+
+void HospitalSystem::getNextPatient() {
+    int spec = readSpecialization();
+    int from = spec;
+    if (std::optional<Patient> p = callNext(spec, &from)) {
+        std::cout << "\t" << p->name;
+        if (from != spec) std::cout << " (from specialization " << from + 1 << ")";
+        std::cout << ", please go with the Dr\n";
+    } else {
+        std::cout << "\tNo patients at the moment. Have rest, Dr\n";
+    }
+}
+
+std::vector<PatientLocation> HospitalSystem::findPatients(const std::string &name,
+                                                          size_t limit) const {
+    std::lock_guard<std::mutex> lock(indexLock);
+    std::vector<PatientLocation> found = index.find(name);
+    return found.empty() ? index.findPrefix(name, limit) : found;
+}
+
+void HospitalSystem::findPatient() const {
+    std::string name;
+    std::cout << "\tEnter name or its beginning: ";
+    getline(std::cin, name);
+    trim(name);
+    std::vector<PatientLocation> found = findPatients(name);
+    if (found.empty()) {
+        std::cout << "\tNobody by that name is waiting\n";
+        return;
+    }
+    for (const PatientLocation &at : found) {
+        std::cout << "\t" << at.name << ": specialization " << at.specialization + 1
+                  << ", level " << at.level << ", ";
+        if (at.ahead == 0) {
+            std::cout << "next in line\n";
+        } else {
+            std::cout << at.ahead << " ahead (" << at.aheadInLevel << " of the same level)\n";
         }
-    };
-    std::vector<HospitalQueue> specializations;
-    static bool isValidName(std::string name) {
-        if (name.size() < 3) {
-            return false;
+    }
+}
+
+void HospitalSystem::printAllPatients() const {
+    std::cout << "\n***************\n";
+    for (auto &spec : specializations) {
+        spec.print();
+    }
+    std::cout << "\n***************\n";
+}
+
+void HospitalSystem::printStatistics() const {
+    std::cout << "\n***************\n";
+    std::cout << std::setw(5) << "spec" << std::setw(9) << "waiting" << std::setw(6) << "max"
+              << std::setw(7) << "cap%" << std::setw(10) << "admitted" << std::setw(9)
+              << "called" << std::setw(10) << "rejected" << std::setw(11) << "stolen in"
+              << std::setw(5) << "out" << std::setw(11) << "wait p50"
+              << std::setw(11) << "p90" << std::setw(11) << "p99" << std::setw(11) << "max"
+              << "\n";
+    for (const auto &spec : specializations) {
+        const QueueStats &stats = spec.statistics();
+        if (stats.depth == 0 && stats.admitted == 0 && stats.called == 0 && stats.rejected == 0 &&
+            stats.stealsIn == 0) {
+            continue;
         }
-        for (char c : name) {
-            if (!islower(c) && c != ' ') {
-                return false;
-            }
+        std::cout << std::setw(5) << spec.id + 1 << std::setw(9) << stats.depth.load()
+                  << std::setw(6) << stats.maxDepth.load() << std::setw(7);
+        if (spec.capacity()) {
+            std::cout << 100 * stats.maxDepth.load() / static_cast<int64_t>(spec.capacity());
+        } else {
+            std::cout << "-";
         }
-        return true;
-    }
-    static std::string readName() {
-        std::string ret;
-        std::cout << "\tEnter name: ";
-        getline(std::cin, ret);
-        trim(ret);
-        while (!isValidName(ret)) {
-            std::cout << "\tInvlid name. Try again: ";
-            getline(std::cin, ret);
-            trim(ret);
+        std::cout << std::setw(10) << stats.admitted.load() << std::setw(9) << stats.called.load()
+                  << std::setw(10) << stats.rejected.load() << std::setw(11)
+                  << stats.stealsIn.load() << std::setw(5) << stats.stealsOut.load();
+        for (double fraction : {0.5, 0.9, 0.99}) {
+            std::cout << std::setw(11) << formatMicros(stats.wait.percentile(fraction));
         }
-        return ret;
+        std::cout << std::setw(11) << formatMicros(stats.wait.max()) << "\n";
     }
-    static int readInRange(const std::string &prompt, int indentTabs, int start, int end) {
-        std::string errorMessage = "Value must be between " + std::to_string(start) + " and " +
-                                   std::to_string(end) + ".\n";
-        return Sefn::readValidatedInput<int>(
-            prompt, indentTabs, [start, end](int r) { return r >= start && r <= end; },
-            errorMessage);
+    std::cout << "\n***************\n";
+    if (writeStatistics()) std::cout << "Statistics written to " << STATS_FILE << "\n";
+}
+
+bool HospitalSystem::writeStatistics(const std::string &path) const {
+    std::ofstream file(path);
+    file << "{\"levels\": " << levelCount << ", \"specializations\": [\n";
+    for (size_t s = 0; s < specializations.size(); ++s) {
+        const HospitalQueue &spec = specializations[s];
+        file << "  " << spec.statistics().toJson(spec.id + 1, spec.capacity())
+             << (s + 1 < specializations.size() ? ",\n" : "\n");
     }
-    int readSpecialization() {
-        std::string prompt = "Enter specialization[1 - " + std::to_string(MAX_SPEC) + "]: ";
-        static const int indentTabs = 1;
-        return readInRange(prompt, indentTabs, 1, MAX_SPEC);
+    file << "]}\n";
+    return static_cast<bool>(file);
+}
+
+void HospitalSystem::resetSpecializations() {
+    specializations.clear();
+    for (int id = 0; id < specializationCount; ++id) {
+        specializations.emplace_back(id, levelCount, queueCapacity, concurrent, agingStep);
     }
-    static bool readStatus() {
-        static const std::string prompt = "Enter status(0 or 1): ";
-        return readInRange(prompt, 1, 0, 1);
+}
+
+void HospitalSystem::rebuildIndex() {
+    std::lock_guard<std::mutex> lock(indexLock);
+    index.clear();
+    for (const HospitalQueue &spec : specializations) {
+        spec.forEach([&](const Patient &p) { index.add(spec.id, p); });
     }
+}
 
-    // Core Business Logic
+bool HospitalSystem::ensureSpecialization(int id) {
+    if (id < specializationCount) return true;
+    if (id >= MAX_SPECIALIZATIONS) return false;
+    specializationCount = id + 1;
+    for (int next = static_cast<int>(specializations.size()); next < specializationCount;
+         ++next) {
+        specializations.emplace_back(next, levelCount, queueCapacity, concurrent, agingStep);
+    }
+    return true;
+}
 
-    void addPatient() {
-        int spec = readSpecialization();
-        specializations[spec].id = spec;
-        Patient p = Patient(readName(), readStatus());
+uint64_t HospitalSystem::loadBinaryDatabase() {
+    BinaryDatabase::ReadResult result;
+    std::string error;
+    auto load = [this](int spec, Patient p) {
+        if (!ensureSpecialization(spec)) {
+            std::cerr << "Warning: Specialization " << spec + 1
+                      << " is out of range, dropping patient: " << p.toString() << std::endl;
+            return;
+        }
+        p.level = std::min(p.level, levelCount);
         if (!specializations[spec].push(p)) {
-            std::cout << "Sorry, we cannot add anymore patients at this specialization\n";
+            patientsDropped = true;
+            std::cerr << "Warning: Specialization " << spec + 1
+                      << " is full, dropping patient: " << p.toString() << std::endl;
         }
+    };
+    if (!BinaryDatabase::read(BINARY_DATABASE_FILE, load, result, error)) {
+        throw std::runtime_error(std::string(BINARY_DATABASE_FILE) + ": " + error);
     }
+    if (result.damaged > 0) {
+        std::cerr << "Warning: Skipped " << result.damaged << " damaged part(s), "
+                  << result.damagedBytes << " bytes, of " << BINARY_DATABASE_FILE << std::endl;
+    }
+    return result.checkpointLsn;
+}
 
-    void getNextPatient() {
-        int spec = readSpecialization();
-        auto [success, p] = specializations[spec].pop();
-        if (success) {
-            std::cout << "\t" << p.name << ", please go with the Dr\n";
-        } else {
-            std::cout << "\tNo patients at the moment. Have rest, Dr\n";
-        }
+void HospitalSystem::loadDatabase() {
+    resetSpecializations();
+    patientsDropped = false;
+    binaryDatabase = std::filesystem::exists(BINARY_DATABASE_FILE);
+    replayLog(binaryDatabase ? loadBinaryDatabase() : loadTextDatabase());
+    rebuildIndex();
+    if (patientsDropped) {
+        std::cerr << "Warning: Patients were dropped while loading; no checkpoints this session, "
+                     "so the database and the log keep them. Restart with a larger capacity."
+                  << std::endl;
     }
+    // Count from here: loading and replaying are not patient traffic
+    for (auto &spec : specializations) spec.resetStatistics();
+}
 
-    void printAllPatients() const {
-        std::cout << "\n***************\n";
-        for (auto &spec : specializations) {
-            if (spec.id != -1) {
-                spec.print();
+uint64_t HospitalSystem::loadTextDatabase() {
+    std::ifstream database(DATABASE_FILE);
+    std::string spec_str;
+    uint64_t checkpointLsn = 0;
+    const std::string tag = CHECKPOINT_TAG;
+    while (getline(database, spec_str)) {
+        if (spec_str.compare(0, tag.size(), tag) == 0) {
+            try {
+                checkpointLsn = std::stoull(spec_str.substr(tag.size()));
+            } catch (const std::exception &e) {
+                std::cerr << "Warning: Corrupted checkpoint tag in file: " << spec_str
+                          << std::endl;
             }
+            continue;
         }
-        std::cout << "\n***************\n";
+        HospitalQueue spec =
+            HospitalQueue(spec_str, levelCount, queueCapacity, concurrent, agingStep);
+        if (spec.id < 0) continue;
+        if (spec.droppedOnLoad() > 0) patientsDropped = true;
+        if (!ensureSpecialization(spec.id)) {
+            std::cerr << "Warning: Skipping out-of-range specialization " << spec.id + 1
+                      << " in " << DATABASE_FILE << std::endl;
+            continue;
+        }
+        specializations[spec.id] = std::move(spec);
     }
+    return checkpointLsn;
+}
 
-    /**
-     * @brief Loads the hospital state from 'patients.txt'.
-     */
-    void loadDatabase() {
-        std::ifstream database("patients.txt");
-        std::string spec_str;
-        specializations.clear();
-        specializations.resize(MAX_SPEC);
-        while (getline(database, spec_str)) {
-            HospitalQueue spec = HospitalQueue(spec_str);
-            specializations[spec.id] = spec;
+void HospitalSystem::replayLog(uint64_t checkpointLsn) {
+    wal = std::make_unique<WriteAheadLog>(WriteAheadLog::DEFAULT_FILE, durability);
+    std::vector<WriteAheadLog::Record> records = wal->recover(checkpointLsn);
+    if (records.empty()) return;
+
+    // Patients admitted in the log, per specialization and in order. A call removes the
+    // patient from there; a call of a patient not admitted in the log must concern the
+    // checkpoint. In concurrent mode a call can even be logged just before its admission.
+    std::vector<std::deque<std::string>> admitted;
+    std::vector<std::unordered_map<std::string, int>> called;
+    for (const WriteAheadLog::Record &record : records) {
+        if (!ensureSpecialization(record.spec)) {
+            std::cerr << "Warning: Skipping log record " << record.lsn
+                      << " of out-of-range specialization " << record.spec + 1 << std::endl;
+            continue;
+        }
+        if (admitted.size() <= static_cast<size_t>(record.spec)) {
+            admitted.resize(record.spec + 1);
+            called.resize(record.spec + 1);
+        }
+        std::deque<std::string> &queue = admitted[record.spec];
+        int &pendingCalls = called[record.spec][record.patient];
+        if (record.op == WriteAheadLog::Op::Admit) {
+            if (pendingCalls > 0) {
+                --pendingCalls;
+            } else {
+                queue.push_back(record.patient);
+            }
+            continue;
+        }
+        auto match = std::find(queue.begin(), queue.end(), record.patient);
+        if (match != queue.end()) {
+            queue.erase(match);
+        } else {
+            ++pendingCalls;
         }
-        database.close();
     }
 
-    /**
-     * @brief Saves the current hospital state to 'patients.txt'.
-     */
-    void updateDatabase() {
-        std::ofstream database("patients.txt");
-        for (auto &spec : specializations) {
-            if (!spec.isEmpty()) database << spec.toString() << "\n";
+    for (size_t spec = 0; spec < admitted.size(); ++spec) {
+        HospitalQueue &queue = specializations[spec];
+        std::vector<Patient> waiting;
+        while (std::optional<Patient> p = queue.pop()) {
+            int &pendingCalls = called[spec][p->toString()];
+            if (pendingCalls > 0) {
+                --pendingCalls;
+            } else {
+                waiting.push_back(std::move(*p));
+            }
+        }
+        for (const Patient &p : waiting) queue.push(p);
+        for (const std::string &p : admitted[spec]) {
+            if (!queue.push(Patient::parse(p, levelCount))) {
+                patientsDropped = true;
+                std::cerr << "Warning: Specialization " << spec + 1
+                          << " is full, dropping patient: " << p << std::endl;
+            }
         }
-        database.close();
     }
+    std::cout << "Recovered " << records.size() << " operations from "
+              << WriteAheadLog::DEFAULT_FILE << "\n";
+    if (!patientsDropped) updateDatabase();
+}
 
-   public:
-    /**
-     * @brief Starts the application loop.
-     */
-    void run() {
-        std::cout << "\n**********Welcome**********\n";
-        loadDatabase();
-        while (true) {
-            std::cout << "\nEnter your choice: \n";
-            std::cout << "\t1) Add a new patient\n";
-            std::cout << "\t2) Print all patients\n";
-            std::cout << "\t3) Get next patient\n";
-            std::cout << "\t4) Exit\n";
-            int choice = readInRange("", 0, 1, 4);
-            switch (choice) {
-                case 1:
-                    addPatient();
-                    break;
-                case 2:
-                    printAllPatients();
-                    break;
-                case 3:
-                    getNextPatient();
-                    break;
-                case 4:
-                    updateDatabase();
-                    std::cout << "\n************Bye************\n";
-                    return;
-            }
+void HospitalSystem::updateDatabase() {
+    if (binaryDatabase) {
+        BinaryDatabase::Writer database(wal ? wal->lastLsn() : 0);
+        for (const HospitalQueue &spec : specializations) {
+            spec.forEach([&](const Patient &p) { database.add(spec.id, p); });
         }
+        if (!durableReplace(BINARY_DATABASE_FILE, database.contents())) {
+            std::cerr << "Error: Cannot write " << BINARY_DATABASE_FILE << ", keeping the log"
+                      << std::endl;
+            return;
+        }
+        if (wal) wal->reset();
+        return;
+    }
+    std::ostringstream database;
+    database << CHECKPOINT_TAG << (wal ? wal->lastLsn() : 0) << "\n";
+    for (auto &spec : specializations) {
+        if (!spec.isEmpty()) database << spec.toString() << "\n";
+    }
+    if (!durableReplace(DATABASE_FILE, database.str())) {
+        std::cerr << "Error: Cannot write " << DATABASE_FILE << ", keeping the log" << std::endl;
+        return;
     }
-};
+    if (wal) wal->reset();
+}
 
-int main() {
-    HospitalSystem system;
-    system.run();
-    return 0;
-}
\ No newline at end of file
+void HospitalSystem::run() {
+    std::cout << "\n**********Welcome**********\n";
+    loadDatabase();
+    while (true) {
+        std::cout << "\nEnter your choice: \n";
+        std::cout << "\t1) Add a new patient\n";
+        std::cout << "\t2) Print all patients\n";
+        std::cout << "\t3) Get next patient\n";
+        std::cout << "\t4) Show statistics\n";
+        std::cout << "\t5) Find a patient\n";
+        std::cout << "\t6) Exit\n";
+        int choice = readInRange("", 0, 1, 6);
+        switch (choice) {
+            case 1:
+                addPatient();
+                break;
+            case 2:
+                printAllPatients();
+                break;
+            case 3:
+                getNextPatient();
+                break;
+            case 4:
+                printStatistics();
+                break;
+            case 5:
+                findPatient();
+                break;
+            case 6:
+                if (!patientsDropped) updateDatabase();
+                writeStatistics();
+                std::cout << "\n************Bye************\n";
+                return;
+        }
+        if (!patientsDropped && wal->recordsSinceReset() >= CHECKPOINT_RECORDS) {
+            updateDatabase();
+        }
+    }
+}
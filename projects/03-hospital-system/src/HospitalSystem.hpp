@@ -0,0 +1,211 @@
+/**
+ * @file HospitalSystem.hpp
+ * @brief Main system class for managing hospital operations.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "DatabaseFormat.hpp"
+#include "HospitalQueue.hpp"
+#include "Patient.hpp"
+#include "PatientIndex.hpp"
+#include "TriageQueue.hpp"
+#include "WriteAheadLog.hpp"
+
+/**
+ * @brief Main system class for managing hospital operations.
+ *
+ * Handles patient intake, queue management for different specializations,
+ * and data persistence. In concurrent mode admit() and callNext() may be called from many
+ * threads at once, e.g. several registration desks and doctors.
+ *
+ * Once the database is loaded, every admitted and called patient is appended to a
+ * WriteAheadLog before admit() or callNext() returns, so a crash loses nothing; the log is
+ * folded into 'patients.txt' every CHECKPOINT_RECORDS records and on exit.
+ *
+ * Specializations can be grouped (see setGroups()): a doctor with nobody waiting in their own
+ * specialization then takes the next patient of the most loaded specialization in the group.
+ *
+ * A PatientIndex follows every admitted and called patient, so findPatients() tells where a
+ * patient waits without scanning the queues.
+ */
+class HospitalSystem {
+   public:
+    static constexpr int DEFAULT_SPECIALIZATIONS = 20;
+    static constexpr int MAX_SPECIALIZATIONS = DatabaseFormat::MAX_SPECIALIZATIONS;
+    static constexpr int DEFAULT_LEVELS = 5;  ///< ESI 1 (resuscitation) to 5 (non-urgent)
+    static constexpr size_t UNLIMITED = TriageQueue<int>::UNBOUNDED;
+    static constexpr const char *DATABASE_FILE = "patients.txt";
+    static constexpr const char *BINARY_DATABASE_FILE = "patients.bin";  ///< See BinaryDatabase
+    static constexpr const char *CHECKPOINT_TAG = DatabaseFormat::CHECKPOINT_TAG;
+    static constexpr size_t CHECKPOINT_RECORDS = 1000;
+    static constexpr const char *STATS_FILE = "hospital_stats.json";
+    static constexpr size_t SEARCH_RESULTS = 10;  ///< Names listed for a prefix search
+
+   private:
+    int specializationCount;
+    int levelCount;
+    size_t queueCapacity;
+    bool concurrent;
+    WriteAheadLog::Sync durability;
+    int64_t agingStep;  ///< Nanoseconds of waiting worth one triage level, 0 for no aging
+
+    std::vector<HospitalQueue> specializations;
+    std::vector<std::vector<int>> siblings;  ///< Per specialization, the others in its group
+    std::unique_ptr<WriteAheadLog> wal;      ///< Opened by loadDatabase()
+    bool binaryDatabase{false};              ///< Checkpoints go to BINARY_DATABASE_FILE
+    bool patientsDropped{false};             ///< Some did not fit while loading: no checkpoints
+    PatientIndex index;
+    mutable std::mutex indexLock;  ///< Guards `index` against concurrent admits and calls
+
+    static std::string readName();
+    static int readInRange(const std::string &prompt, int indentTabs, int start, int end);
+
+    /**
+     * @brief Pops the next patient of the most loaded sibling of `spec`, if any waits.
+     * @param from Set to the sibling the patient was taken from.
+     */
+    std::optional<Patient> steal(int spec, int &from);
+
+    /**
+     * @brief Reads a specialization number (1-based) and returns its index.
+     */
+    int readSpecialization();
+    int readLevel() const;
+
+    // Core Business Logic
+
+    void addPatient();
+    void getNextPatient();
+    void printAllPatients() const;
+    void findPatient() const;
+
+    /**
+     * @brief Prints the queue depths, counters and wait percentiles of every specialization
+     * that has seen a patient, and writes them all to STATS_FILE.
+     */
+    void printStatistics() const;
+    void resetSpecializations();
+
+    /**
+     * @brief Indexes every waiting patient anew, after the queues were filled directly.
+     */
+    void rebuildIndex();
+
+    /**
+     * @brief Adds empty specializations up to index `id`.
+     * @return False, adding nothing, if `id` is not below MAX_SPECIALIZATIONS.
+     */
+    bool ensureSpecialization(int id);
+
+    /**
+     * @brief Loads the hospital state from 'patients.bin' if it exists, else from
+     * 'patients.txt', then replays the log records written after it.
+     *
+     * Specializations in the file beyond the configured count are added.
+     */
+    void loadDatabase();
+
+    /**
+     * @brief Fills the queues from 'patients.txt'.
+     * @return The checkpoint lsn, 0 if there is no file or tag.
+     */
+    uint64_t loadTextDatabase();
+
+    /**
+     * @brief Fills the queues from 'patients.bin', skipping damaged records.
+     * @return The checkpoint lsn.
+     * @throws std::runtime_error if the file is not a readable database.
+     */
+    uint64_t loadBinaryDatabase();
+
+    /**
+     * @brief Applies the log records after the checkpoint `checkpointLsn` and opens the log.
+     */
+    void replayLog(uint64_t checkpointLsn);
+
+    /**
+     * @brief Saves the current hospital state to the database file it was loaded from (a
+     * checkpoint) and empties the log. Only while no other thread admits or calls patients.
+     *
+     * Not called once loading has had to drop patients, which a checkpoint would lose for good.
+     */
+    void updateDatabase();
+
+   public:
+    /**
+     * @param specializations Number of specializations.
+     * @param levels Number of triage levels, 1 to TriageQueue::MAX_LEVELS.
+     * @param capacity Maximum patients waiting per specialization, or UNLIMITED.
+     * @param concurrent Back every specialization with a lock-free ConcurrentTriageQueue.
+     * @param durability When the write-ahead log forces records to disk.
+     * @param agingMinutes Waiting time that counts as one triage level more urgent (see
+     * AgingQueue), or 0 for strict triage order. Not available in concurrent mode.
+     */
+    explicit HospitalSystem(int specializations = DEFAULT_SPECIALIZATIONS,
+                            int levels = DEFAULT_LEVELS, size_t capacity = UNLIMITED,
+                            bool concurrent = false,
+                            WriteAheadLog::Sync durability = WriteAheadLog::Sync::GroupCommit,
+                            double agingMinutes = 0);
+
+    /**
+     * @brief Parses groups of specializations: groups separated by commas, members by '+',
+     * and 'a-b' for a range, all 1-based; "1-3,7+9" gives {0, 1, 2} and {6, 8}.
+     * @throws std::invalid_argument on malformed text.
+     */
+    static std::vector<std::vector<int>> parseGroups(const std::string &text);
+
+    /**
+     * @brief Lets the doctors of each group serve each other's patients (work stealing).
+     * Replaces any earlier groups; call before run() or while no patient is called.
+     * @param groups Specialization indexes (0-based); each in at most one group.
+     * @throws std::invalid_argument on an unknown or repeated specialization.
+     */
+    void setGroups(const std::vector<std::vector<int>> &groups);
+
+    /**
+     * @brief Queues a patient and logs it; thread-safe in concurrent mode.
+     * @param spec Specialization index (0-based).
+     * @return false if the specialization is full.
+     */
+    bool admit(int spec, const Patient &p);
+
+    /**
+     * @brief Removes the next patient of a specialization and logs it; thread-safe in
+     * concurrent mode. If nobody waits there, takes the highest-priority patient of the most
+     * loaded specialization in its group instead.
+     * @param spec Specialization index (0-based).
+     * @param from If given, set to the specialization the patient was queued in.
+     * @return The patient, or nothing if nobody is waiting in the whole group.
+     */
+    std::optional<Patient> callNext(int spec, int *from = nullptr);
+
+    /**
+     * @brief Where the waiting patients named `name` are; if there is none, the patients of
+     * the first `limit` names starting with `name`. Thread-safe.
+     */
+    std::vector<PatientLocation> findPatients(const std::string &name,
+                                              size_t limit = SEARCH_RESULTS) const;
+
+    /**
+     * @brief Writes every specialization's statistics as JSON, including the wait
+     * histograms; safe while other threads admit and call patients.
+     * @return False if the file cannot be written.
+     */
+    bool writeStatistics(const std::string &path = STATS_FILE) const;
+
+    int specializationsCount() const { return specializationCount; }
+    int levelsCount() const { return levelCount; }
+
+    /**
+     * @brief Starts the application loop.
+     */
+    void run();
+};
@@ -0,0 +1,38 @@
+#include "Patient.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+Patient Patient::parse(const std::string &str, int levels) {
+    size_t digits = str.find_first_not_of("0123456789");
+    if (digits == 0 || digits == std::string::npos || digits > 9 ||
+        !isValidName(str.substr(digits))) {
+        // Handle the error gracefully. For now, let's create an invalid patient.
+        std::cerr << "Warning: Corrupted patient data found in file: " << str << std::endl;
+        return Patient("INVALID_DATA", levels);
+    }
+    int stored = std::stoi(str.substr(0, digits));
+    return Patient(str.substr(digits), stored == 0 ? levels : std::min(stored, levels));
+}
+
+std::string Patient::toString() const {
+    std::ostringstream oss;
+    oss << level << name;
+    return oss.str();
+}
+
+void Patient::print() const {
+    std::cout << "\t" << std::left << std::setw(25) << name;
+    std::cout << "\tlevel " << level << (level == 1 ? " (most urgent)\n" : "\n");
+}
+
+bool Patient::isValidName(const std::string &name) {
+    if (name.size() < 3) {
+        return false;
+    }
+    // Plain comparisons, not islower(): a locale lookup per character slows loading millions
+    return std::all_of(name.begin(), name.end(),
+                       [](char c) { return (c >= 'a' && c <= 'z') || c == ' '; });
+}
@@ -0,0 +1,50 @@
+/**
+ * @file Patient.hpp
+ * @brief A waiting patient: name and triage level.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Represents a single patient record.
+ *
+ * The timestamps are steady-clock nanoseconds (see now()), set by HospitalQueue; they are not
+ * saved, so patients loaded from disk count as queued at load time.
+ */
+struct Patient {
+    int level{1};  ///< Triage level: 1 is the most urgent
+    std::string name;
+    int64_t enqueuedAt{0};  ///< When the patient was queued, 0 if never
+    int64_t dequeuedAt{0};  ///< When a doctor called the patient, 0 if not yet
+
+    Patient(std::string name, int level) : level(level), name(std::move(name)) {}
+    Patient() = default;
+
+    /**
+     * @brief Deserializes a patient from a string: the level's digits, then the name.
+     *
+     * Files from the two-priority version store 1 (urgent) or 0 (regular) instead: urgent
+     * maps to level 1 and regular to the least urgent level.
+     * @param str Formatted string from the database file.
+     * @param levels Number of triage levels; larger levels are clamped to the last one.
+     */
+    static Patient parse(const std::string &str, int levels);
+
+    std::string toString() const;
+    void print() const;
+
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /**
+     * @brief Names are at least 3 characters of lowercase letters and spaces.
+     */
+    static bool isValidName(const std::string &name);
+};
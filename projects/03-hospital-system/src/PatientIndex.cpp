@@ -0,0 +1,183 @@
+#include "PatientIndex.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+int32_t NameTrie::child(int32_t node, char letter) const {
+    for (int32_t next = nodes[node].child; next >= 0; next = nodes[next].sibling) {
+        if (nodes[next].letter == letter) return next;
+        if (nodes[next].letter > letter) break;
+    }
+    return -1;
+}
+
+int32_t NameTrie::addChild(int32_t node, char letter) {
+    int32_t previous = -1;
+    int32_t next = nodes[node].child;
+    while (next >= 0 && nodes[next].letter < letter) {
+        previous = next;
+        next = nodes[next].sibling;
+    }
+    if (next >= 0 && nodes[next].letter == letter) return next;
+    Node added;
+    added.letter = letter;
+    added.sibling = next;
+    auto index = static_cast<int32_t>(nodes.size());
+    nodes.push_back(added);  // may reallocate: no references into `nodes` are held here
+    if (previous < 0) {
+        nodes[node].child = index;
+    } else {
+        nodes[previous].sibling = index;
+    }
+    return index;
+}
+
+void NameTrie::insert(const std::string &name) {
+    int32_t node = 0;
+    ++nodes[node].passing;
+    for (char letter : name) {
+        node = addChild(node, letter);
+        ++nodes[node].passing;
+    }
+    ++nodes[node].ending;
+}
+
+void NameTrie::erase(const std::string &name) {
+    int32_t node = 0;
+    --nodes[node].passing;
+    for (char letter : name) {
+        node = child(node, letter);
+        assert(node >= 0 && nodes[node].passing > 0);
+        --nodes[node].passing;
+    }
+    --nodes[node].ending;
+}
+
+std::vector<std::string> NameTrie::withPrefix(const std::string &prefix, size_t limit) const {
+    std::vector<std::string> names;
+    int32_t start = 0;
+    for (char letter : prefix) {
+        start = child(start, letter);
+        if (start < 0 || nodes[start].passing == 0) return names;
+    }
+    std::string name = prefix;
+    // Depth-first, children in letter order, so names come out sorted
+    auto visit = [&](auto &self, int32_t node) -> void {
+        if (nodes[node].ending > 0) names.push_back(name);
+        for (int32_t next = nodes[node].child; next >= 0 && names.size() < limit;
+             next = nodes[next].sibling) {
+            if (nodes[next].passing == 0) continue;
+            name.push_back(nodes[next].letter);
+            self(self, next);
+            name.pop_back();
+        }
+    };
+    if (limit > 0) visit(visit, start);
+    return names;
+}
+
+void NameTrie::clear() { nodes.assign(1, Node{}); }
+
+PatientIndex::PatientIndex(int levels, int64_t agingStep)
+    : levelCount(levels), agingStep(agingStep) {
+    assert(levels >= 1);
+}
+
+PatientIndex::LevelCounters &PatientIndex::countersOf(int spec, int level) {
+    assert(spec >= 0 && level >= 0 && level < levelCount);
+    if (counters.size() <= static_cast<size_t>(spec)) {
+        counters.resize(spec + 1, std::vector<LevelCounters>(levelCount));
+    }
+    return counters[spec][level];
+}
+
+void PatientIndex::add(int spec, const Patient &p) {
+    int level = p.level - 1;
+    LevelCounters &counts = countersOf(spec, level);
+    auto [first, last] = byName.equal_range(p.name);
+    auto early = std::find_if(first, last, [&](const auto &named) {
+        const Entry &e = named.second;
+        return e.ticket == CALLED_EARLY && e.spec == spec && e.level == level;
+    });
+    if (early != last) {
+        // Already called: it came and went
+        byName.erase(early);
+        ++counts.pushed;
+        ++counts.popped;
+        return;
+    }
+    int64_t key = p.enqueuedAt + level * agingStep;
+    byName.emplace(p.name, Entry{spec, level, counts.pushed++, key});
+    if (agingStep > 0) counts.keys.push_back(key);
+    trie.insert(p.name);
+    ++count;
+}
+
+void PatientIndex::remove(int spec, const Patient &p) {
+    int level = p.level - 1;
+    LevelCounters &counts = countersOf(spec, level);
+    auto [first, last] = byName.equal_range(p.name);
+    // Namesakes of one level leave in the order they came
+    auto oldest = last;
+    for (auto named = first; named != last; ++named) {
+        const Entry &e = named->second;
+        if (e.spec == spec && e.level == level && e.ticket != CALLED_EARLY &&
+            (oldest == last || e.ticket < oldest->second.ticket)) {
+            oldest = named;
+        }
+    }
+    if (oldest == last) {
+        byName.emplace(p.name, Entry{spec, level, CALLED_EARLY, 0});
+        return;
+    }
+    byName.erase(oldest);
+    ++counts.popped;
+    if (!counts.keys.empty()) counts.keys.pop_front();
+    trie.erase(p.name);
+    --count;
+}
+
+PatientLocation PatientIndex::locate(const std::string &name, const Entry &entry) const {
+    const std::vector<LevelCounters> &levels = counters[entry.spec];
+    const LevelCounters &own = levels[entry.level];
+    // Concurrent pushes can leave a ticket behind the pops for a moment
+    size_t inLevel = entry.ticket > own.popped ? entry.ticket - own.popped : 0;
+    size_t ahead = inLevel;
+    for (int level = 0; level < levelCount; ++level) {
+        if (level == entry.level) continue;
+        const LevelCounters &other = levels[level];
+        if (agingStep > 0) {
+            ahead += std::lower_bound(other.keys.begin(), other.keys.end(), entry.key) -
+                     other.keys.begin();
+        } else if (level < entry.level) {
+            ahead += other.pushed > other.popped ? other.pushed - other.popped : 0;
+        }
+    }
+    return {name, entry.spec, entry.level + 1, ahead, inLevel};
+}
+
+std::vector<PatientLocation> PatientIndex::find(const std::string &name) const {
+    std::vector<PatientLocation> found;
+    auto [first, last] = byName.equal_range(name);
+    for (auto named = first; named != last; ++named) {
+        if (named->second.ticket != CALLED_EARLY) found.push_back(locate(name, named->second));
+    }
+    return found;
+}
+
+std::vector<PatientLocation> PatientIndex::findPrefix(const std::string &prefix,
+                                                      size_t limit) const {
+    std::vector<PatientLocation> found;
+    for (const std::string &name : trie.withPrefix(prefix, limit)) {
+        std::vector<PatientLocation> namesakes = find(name);
+        found.insert(found.end(), namesakes.begin(), namesakes.end());
+    }
+    return found;
+}
+
+void PatientIndex::clear() {
+    byName.clear();
+    counters.clear();
+    trie.clear();
+    count = 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file PatientIndex.hpp
+ * @brief Finds waiting patients by name or name prefix, with their place in the queue.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Patient.hpp"
+
+/**
+ * @class NameTrie
+ * @brief Prefix tree of names, counting duplicates, for prefix search in alphabetical order.
+ *
+ * Children are kept as a sorted sibling list: names are short and use few letters, so this is
+ * far smaller than a 27-way array per node. Nodes of removed names stay allocated, with a
+ * zero count, and are reused when a name with the same prefix comes back.
+ */
+class NameTrie {
+   public:
+    void insert(const std::string &name);
+
+    /**
+     * @brief Removes one copy of a name that was inserted.
+     */
+    void erase(const std::string &name);
+
+    /**
+     * @brief Up to `limit` distinct names starting with `prefix`, in alphabetical order.
+     */
+    std::vector<std::string> withPrefix(const std::string &prefix, size_t limit) const;
+
+    void clear();
+
+   private:
+    struct Node {
+        int32_t child{-1};    ///< First child, the one with the smallest character
+        int32_t sibling{-1};  ///< Next child of the same parent
+        uint32_t passing{0};  ///< Names through this node, copies included
+        uint32_t ending{0};   ///< Names that end here, copies included
+        char letter{0};
+    };
+
+    std::vector<Node> nodes{Node{}};  ///< nodes[0] is the root
+
+    int32_t child(int32_t node, char letter) const;
+    int32_t addChild(int32_t node, char letter);
+};
+
+/**
+ * @struct PatientLocation
+ * @brief Where a waiting patient is.
+ */
+struct PatientLocation {
+    std::string name;
+    int specialization;   ///< 0-based
+    int level;            ///< Triage level, 1 is the most urgent
+    size_t ahead;         ///< Patients who will be called before them in their specialization
+    size_t aheadInLevel;  ///< Those of them with the same level
+};
+
+/**
+ * @class PatientIndex
+ * @brief Name index of every waiting patient: a hash map for exact names and a NameTrie for
+ * prefixes, with each patient's rank in their specialization.
+ *
+ * Ranks come from sequence counters instead of stored positions: every (specialization,
+ * level) counts its pushes and pops, and a patient keeps the push count it got, so the
+ * patients ahead of it in its level are its number minus the pops. Every queue type calls a
+ * level's patients first come, first served, so a push or pop is O(1) and nothing is ever
+ * renumbered. Patients of other levels ahead are the live counts of the more urgent levels, or
+ * with aging a binary search of each level's aging keys, which are sorted in arrival order.
+ * Lookups are O(levels) (O(levels log n) with aging), a fraction of a microsecond.
+ *
+ * The index mirrors the queues: add() after every successful push and remove() after every
+ * pop, for the specialization the patient was queued in. Not thread-safe. With concurrent
+ * queues a pop may be reported before the push it undoes: remove() then remembers it and the
+ * matching add() cancels out. Patients of one level pushed at the same moment from different
+ * threads may have their ranks swapped.
+ */
+class PatientIndex {
+   public:
+    /**
+     * @param levels Number of triage levels.
+     * @param agingStep As HospitalQueue: nanoseconds of waiting worth one level, 0 for strict
+     * triage order.
+     */
+    explicit PatientIndex(int levels, int64_t agingStep = 0);
+
+    /**
+     * @brief Records a patient just queued in `spec`, stamped with its enqueue time.
+     */
+    void add(int spec, const Patient &p);
+
+    /**
+     * @brief Records a patient just called from `spec`.
+     */
+    void remove(int spec, const Patient &p);
+
+    /**
+     * @brief Every waiting patient with exactly this name.
+     */
+    std::vector<PatientLocation> find(const std::string &name) const;
+
+    /**
+     * @brief Every waiting patient of the first `limit` names starting with `prefix`, in
+     * alphabetical order.
+     */
+    std::vector<PatientLocation> findPrefix(const std::string &prefix, size_t limit) const;
+
+    size_t size() const { return count; }
+    void clear();
+
+   private:
+    static constexpr uint64_t CALLED_EARLY = UINT64_MAX;  ///< Ticket of a pop seen before its push
+
+    struct Entry {
+        int spec;
+        int level;        ///< 0-based
+        uint64_t ticket;  ///< The level's push count when queued
+        int64_t key;      ///< Aging key, as AgingQueue computes it
+    };
+
+    struct LevelCounters {
+        uint64_t pushed{0};
+        uint64_t popped{0};
+        std::deque<int64_t> keys;  ///< Aging keys of the waiting patients, oldest first
+    };
+
+    int levelCount;
+    int64_t agingStep;
+    std::unordered_multimap<std::string, Entry> byName;  ///< Entries inline: one miss less
+    std::vector<std::vector<LevelCounters>> counters;  ///< Per specialization and level
+    NameTrie trie;
+    size_t count{0};
+
+    LevelCounters &countersOf(int spec, int level);
+    PatientLocation locate(const std::string &name, const Entry &entry) const;
+};
@@ -0,0 +1,146 @@
+#include "QueueStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace {
+int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int index = 0;
+    while (value >>= 1) ++index;
+    return index;
+#endif
+}
+
+template <typename T>
+void storeMax(std::atomic<T> &target, T value) {
+    T current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+}  // namespace
+
+int WaitHistogram::bucketOf(uint64_t micros) {
+    if (micros < static_cast<uint64_t>(SUB_BUCKETS)) return static_cast<int>(micros);
+    int shift = highestBit(micros) - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<int>((micros >> shift) - SUB_BUCKETS);
+}
+
+uint64_t WaitHistogram::lowerBound(int bucket) {
+    if (bucket < SUB_BUCKETS) return static_cast<uint64_t>(bucket);
+    int shift = bucket / SUB_BUCKETS - 1;
+    return static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+}
+
+void WaitHistogram::record(uint64_t micros) {
+    micros = std::min(micros, MAX_MICROS);
+    counts[bucketOf(micros)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(micros, std::memory_order_relaxed);
+    storeMax(maxValue, micros);
+}
+
+void WaitHistogram::reset() {
+    for (auto &bucket : counts) bucket.store(0, std::memory_order_relaxed);
+    total = 0;
+    sum = 0;
+    maxValue = 0;
+}
+
+double WaitHistogram::mean() const {
+    uint64_t n = count();
+    return n ? static_cast<double>(sum.load(std::memory_order_relaxed)) / n : 0;
+}
+
+uint64_t WaitHistogram::percentile(double fraction) const {
+    uint64_t n = count();
+    if (n == 0) return 0;
+    auto rank = static_cast<uint64_t>(std::ceil(fraction * n));
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += bucketCount(bucket);
+        if (seen >= std::max<uint64_t>(rank, 1)) {
+            uint64_t highest = bucket + 1 < BUCKETS ? lowerBound(bucket + 1) - 1 : MAX_MICROS;
+            return std::min(highest, max());
+        }
+    }
+    return max();
+}
+
+void QueueStats::onPushStart() { depth.fetch_add(1, std::memory_order_relaxed); }
+
+void QueueStats::onPushed() {
+    admitted.fetch_add(1, std::memory_order_relaxed);
+    storeMax(maxDepth, depth.load(std::memory_order_relaxed));
+}
+
+void QueueStats::onRejected() {
+    depth.fetch_sub(1, std::memory_order_relaxed);
+    rejected.fetch_add(1, std::memory_order_relaxed);
+}
+
+void QueueStats::onPop(int64_t waitNanos) {
+    called.fetch_add(1, std::memory_order_relaxed);
+    depth.fetch_sub(1, std::memory_order_relaxed);
+    wait.record(waitNanos > 0 ? static_cast<uint64_t>(waitNanos) / 1000 : 0);
+}
+
+void QueueStats::reset() {
+    wait.reset();
+    maxDepth = depth.load();
+    admitted = 0;
+    called = 0;
+    rejected = 0;
+    stealsIn = 0;
+    stealsOut = 0;
+}
+
+std::string QueueStats::toJson(int id, size_t capacity) const {
+    std::ostringstream json;
+    json << "{\"id\": " << id << ", \"depth\": " << depth.load()
+         << ", \"max_depth\": " << maxDepth.load() << ", \"capacity\": " << capacity
+         << ", \"admitted\": " << admitted.load() << ", \"called\": " << called.load()
+         << ", \"rejected\": " << rejected.load() << ", \"steals_in\": " << stealsIn.load()
+         << ", \"steals_out\": " << stealsOut.load()
+         << ", \"wait_us\": {\"count\": " << wait.count()
+         << ", \"mean\": " << std::fixed << std::setprecision(1) << wait.mean();
+    for (auto [name, fraction] : {std::pair<const char *, double>{"p50", 0.5},
+                                  {"p90", 0.9},
+                                  {"p99", 0.99},
+                                  {"p999", 0.999}}) {
+        json << ", \"" << name << "\": " << wait.percentile(fraction);
+    }
+    json << ", \"max\": " << wait.max() << ", \"buckets\": [";
+    const char *separator = "";
+    for (int bucket = 0; bucket < WaitHistogram::BUCKETS; ++bucket) {
+        if (uint64_t n = wait.bucketCount(bucket)) {
+            json << separator << "[" << WaitHistogram::lowerBound(bucket) << ", " << n << "]";
+            separator = ", ";
+        }
+    }
+    json << "]}}";
+    return json.str();
+}
+
+std::string formatMicros(uint64_t micros) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1);
+    if (micros < 1000) {
+        text << micros << " us";
+    } else if (micros < 1000000) {
+        text << micros / 1e3 << " ms";
+    } else if (micros < 60000000) {
+        text << micros / 1e6 << " s";
+    } else if (micros < 3600000000) {
+        text << micros / 6e7 << " min";
+    } else {
+        text << micros / 3.6e9 << " h";
+    }
+    return text.str();
+}
@@ -0,0 +1,245 @@
+#include "Simulation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "AgingQueue.hpp"
+#include "TriageQueue.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief An arrival at, or a doctor finishing with a patient of, a specialization.
+ */
+struct Event {
+    double time;  ///< Hours since the start
+    int spec;
+    bool arrival;
+
+    bool operator>(const Event &other) const { return time > other.time; }
+};
+
+struct WaitingPatient {
+    double arrival{0};
+    int level{0};
+};
+
+struct SpecializationState {
+    TriageQueue<WaitingPatient> queue;
+    std::optional<AgingQueue<WaitingPatient, double>> aging;  ///< Replaces `queue` if set
+    std::exponential_distribution<double> interarrival;
+    int idleDoctors;
+    int busyDoctors{0};
+    double lastChange{0};
+    double queueArea{0};  ///< Integral of the queue length over time
+    double busyArea{0};   ///< Integral of the busy doctors over time
+    std::vector<float> waits;
+
+    SpecializationState(int levels, size_t capacity, double agingHours, double arrivalsPerHour,
+                        int doctors)
+        : queue(agingHours > 0 ? 1 : levels, capacity),
+          interarrival(arrivalsPerHour > 0 ? arrivalsPerHour : 1),
+          idleDoctors(doctors) {
+        if (agingHours > 0) aging.emplace(levels, agingHours, capacity);
+    }
+
+    bool push(WaitingPatient patient) {
+        return aging ? aging->push(patient, patient.level, patient.arrival)
+                     : queue.push(patient, patient.level);
+    }
+    std::optional<WaitingPatient> pop() { return aging ? aging->pop() : queue.pop(); }
+    size_t size() const { return aging ? aging->size() : queue.size(); }
+
+    /**
+     * @brief Accumulates the time-weighted averages up to `time`.
+     */
+    void advance(double time) {
+        queueArea += size() * (time - lastChange);
+        busyArea += busyDoctors * (time - lastChange);
+        lastChange = time;
+    }
+};
+
+template <typename T>
+T pick(const std::vector<T> &values, int index) {
+    return values[std::min(static_cast<size_t>(index), values.size() - 1)];
+}
+
+/**
+ * @brief Sorts `waits` (in hours) and summarizes them in minutes.
+ */
+WaitSummary summarize(std::vector<float> &waits) {
+    WaitSummary summary;
+    summary.patients = waits.size();
+    if (waits.empty()) return summary;
+    std::sort(waits.begin(), waits.end());
+    double total = 0;
+    for (float wait : waits) total += wait;
+    auto at = [&waits](double fraction) {
+        return 60.0 * waits[static_cast<size_t>(fraction * (waits.size() - 1))];
+    };
+    summary.mean = 60.0 * total / waits.size();
+    summary.p50 = at(0.5);
+    summary.p90 = at(0.9);
+    summary.p99 = at(0.99);
+    summary.max = 60.0 * waits.back();
+    return summary;
+}
+
+void validate(const SimulationConfig &config) {
+    bool rates = !config.arrivalsPerHour.empty() &&
+                 std::all_of(config.arrivalsPerHour.begin(), config.arrivalsPerHour.end(),
+                             [](double rate) { return rate >= 0; });
+    bool doctors = !config.doctors.empty() &&
+                   std::all_of(config.doctors.begin(), config.doctors.end(),
+                               [](int count) { return count >= 1; });
+    if (config.specializations < 1 || config.levels < 1 ||
+        config.levels > TriageQueue<int>::MAX_LEVELS || !rates || !doctors ||
+        !(config.serviceMinutes > 0) || !(config.urgentRatio >= 0 && config.urgentRatio <= 1) ||
+        !(config.agingMinutes >= 0) || !(config.hours > 0)) {
+        throw std::invalid_argument(
+            "Need specializations >= 1, levels 1-64, arrival rates >= 0, doctors >= 1, "
+            "service minutes > 0, urgent ratio 0-1, aging minutes >= 0 and hours > 0");
+    }
+}
+
+/**
+ * @brief Lists, per specialization, the other members of its group.
+ * @throws std::invalid_argument on an unknown or repeated specialization.
+ */
+std::vector<std::vector<int>> siblingsOf(const SimulationConfig &config) {
+    std::vector<std::vector<int>> siblings(config.specializations);
+    std::vector<bool> seen(config.specializations, false);
+    for (const std::vector<int> &group : config.groups) {
+        for (int spec : group) {
+            if (spec < 0 || spec >= config.specializations || seen[spec]) {
+                throw std::invalid_argument("Specialization " + std::to_string(spec + 1) +
+                                            " is unknown or in more than one group");
+            }
+            seen[spec] = true;
+        }
+        for (int spec : group) {
+            for (int sibling : group) {
+                if (sibling != spec) siblings[spec].push_back(sibling);
+            }
+        }
+    }
+    return siblings;
+}
+}  // namespace
+
+SimulationReport simulate(const SimulationConfig &config) {
+    validate(config);
+    std::vector<std::vector<int>> siblings = siblingsOf(config);
+    auto start = Clock::now();
+
+    std::mt19937_64 rng(config.seed);
+    std::exponential_distribution<double> service(60.0 / config.serviceMinutes);
+    std::vector<double> levelWeights(config.levels, 1.0);
+    if (config.levels > 1) {
+        levelWeights.assign(config.levels, (1 - config.urgentRatio) / (config.levels - 1));
+        levelWeights[0] = config.urgentRatio;
+    }
+    std::discrete_distribution<int> level(levelWeights.begin(), levelWeights.end());
+
+    std::vector<SpecializationState> specs;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    SimulationReport report;
+    report.specializations.resize(config.specializations);
+    std::vector<std::vector<float>> levelWaits(config.levels);
+    specs.reserve(config.specializations);
+    for (int s = 0; s < config.specializations; ++s) {
+        double rate = pick(config.arrivalsPerHour, s);
+        int doctors = pick(config.doctors, s);
+        specs.emplace_back(config.levels, config.capacity, config.agingMinutes / 60, rate,
+                           doctors);
+        report.specializations[s].arrivalsPerHour = rate;
+        report.specializations[s].doctors = doctors;
+        if (rate > 0) events.push({specs[s].interarrival(rng), s, true});
+    }
+
+    // The patient waited at `spec`; the doctor of `doctorSpec` sees them
+    auto startService = [&](int spec, int doctorSpec, double now, double arrival,
+                            int patientLevel) {
+        float wait = static_cast<float>(now - arrival);
+        specs[spec].waits.push_back(wait);
+        levelWaits[patientLevel].push_back(wait);
+        events.push({now + service(rng), doctorSpec, false});
+        if (doctorSpec != spec) {
+            ++report.specializations[doctorSpec].stealsIn;
+            ++report.specializations[spec].stealsOut;
+        }
+    };
+    auto idleSibling = [&](int spec) {
+        for (int sibling : siblings[spec]) {
+            if (specs[sibling].idleDoctors > 0) return sibling;
+        }
+        return -1;
+    };
+    auto busiestSibling = [&](int spec) {
+        int busiest = -1;
+        for (int sibling : siblings[spec]) {
+            size_t waiting = specs[sibling].size();
+            if (waiting > 0 && (busiest < 0 || waiting > specs[busiest].size())) {
+                busiest = sibling;
+            }
+        }
+        return busiest;
+    };
+
+    while (!events.empty() && events.top().time <= config.hours) {
+        Event event = events.top();
+        events.pop();
+        ++report.events;
+        SpecializationState &state = specs[event.spec];
+        SpecializationReport &counts = report.specializations[event.spec];
+        state.advance(event.time);
+
+        if (event.arrival) {
+            events.push({event.time + state.interarrival(rng), event.spec, true});
+            ++counts.arrivals;
+            int patientLevel = level(rng);
+            int doctorSpec = state.idleDoctors > 0 ? event.spec : idleSibling(event.spec);
+            if (doctorSpec >= 0) {
+                SpecializationState &doctor = specs[doctorSpec];
+                doctor.advance(event.time);
+                --doctor.idleDoctors;
+                ++doctor.busyDoctors;
+                startService(event.spec, doctorSpec, event.time, event.time, patientLevel);
+            } else if (state.push({event.time, patientLevel})) {
+                counts.maxQueue = std::max(counts.maxQueue, state.size());
+            } else {
+                ++counts.rejected;
+            }
+        } else if (std::optional<WaitingPatient> next = state.pop()) {
+            startService(event.spec, event.spec, event.time, next->arrival, next->level);
+        } else if (int from = busiestSibling(event.spec); from >= 0) {
+            specs[from].advance(event.time);
+            WaitingPatient stolen = *specs[from].pop();
+            startService(from, event.spec, event.time, stolen.arrival, stolen.level);
+        } else {
+            --state.busyDoctors;
+            ++state.idleDoctors;
+        }
+    }
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (int s = 0; s < config.specializations; ++s) {
+        SpecializationState &state = specs[s];
+        SpecializationReport &counts = report.specializations[s];
+        state.advance(config.hours);
+        counts.served = state.waits.size();
+        counts.finalQueue = state.size();
+        counts.meanQueue = state.queueArea / config.hours;
+        counts.utilization = state.busyArea / (config.hours * counts.doctors);
+        counts.wait = summarize(state.waits);
+    }
+    for (std::vector<float> &waits : levelWaits) report.levels.push_back(summarize(waits));
+    return report;
+}
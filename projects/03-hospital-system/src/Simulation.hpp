@@ -0,0 +1,95 @@
+/**
+ * @file Simulation.hpp
+ * @brief Discrete-event simulation of patient arrivals and doctors, for staffing decisions.
+ *
+ * Patients arrive at every specialization as a Poisson process and wait in the same
+ * TriageQueue the hospital uses, with the same capacity rule. Every specialization has a fixed
+ * number of doctors; a doctor who finishes a patient calls the next one, and a service takes an
+ * exponentially distributed time. Nothing is printed while the simulation runs.
+ *
+ * Grouped specializations share their doctors the way HospitalSystem::callNext() does: an
+ * arrival nobody in its own specialization is free for goes to an idle doctor of the group,
+ * and a doctor whose own queue is empty calls the next patient of the group's longest queue.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct SimulationConfig
+ * @brief Hospital layout, load and run length.
+ */
+struct SimulationConfig {
+    int specializations{20};
+    int levels{5};
+    size_t capacity{0};  ///< Patients waiting per specialization, 0 for unlimited
+
+    /// Arrivals per hour, per specialization; the last rate repeats for the rest
+    std::vector<double> arrivalsPerHour{4.0};
+    /// Doctors per specialization; the last count repeats for the rest
+    std::vector<int> doctors{1};
+    double serviceMinutes{12.0};  ///< Mean time a doctor spends on one patient
+    /// Share of level 1 patients; the others are spread evenly over the remaining levels
+    double urgentRatio{0.1};
+    /// Waiting minutes worth one triage level (an AgingQueue), 0 for strict triage order
+    double agingMinutes{0};
+    /// Groups of specializations (0-based) whose doctors serve each other's patients
+    std::vector<std::vector<int>> groups;
+
+    double hours{24.0 * 365};  ///< Simulated time
+    uint64_t seed{1};
+};
+
+/**
+ * @struct WaitSummary
+ * @brief Waiting times, from arrival to the doctor's call, in minutes.
+ */
+struct WaitSummary {
+    uint64_t patients{0};
+    double mean{0};
+    double p50{0};
+    double p90{0};
+    double p99{0};
+    double max{0};
+};
+
+/**
+ * @struct SpecializationReport
+ * @brief What happened at one specialization.
+ */
+struct SpecializationReport {
+    double arrivalsPerHour{0};
+    int doctors{0};
+    uint64_t arrivals{0};
+    uint64_t rejected{0};   ///< Turned away because the queue was at capacity
+    uint64_t served{0};     ///< Called by a doctor
+    uint64_t stealsIn{0};   ///< Patients of other specializations its doctors served
+    uint64_t stealsOut{0};  ///< Its patients served by doctors of other specializations
+    size_t maxQueue{0};
+    size_t finalQueue{0};
+    double meanQueue{0};    ///< Time-weighted average number of waiting patients
+    double utilization{0};  ///< Share of doctor time spent with patients
+    WaitSummary wait;
+};
+
+/**
+ * @struct SimulationReport
+ * @brief Per-specialization and per-level results of one run.
+ */
+struct SimulationReport {
+    std::vector<SpecializationReport> specializations;
+    std::vector<WaitSummary> levels;  ///< Waits of every specialization, per triage level
+    uint64_t events{0};
+    double seconds{0};  ///< Wall-clock time of the event loop
+
+    double eventsPerSecond() const { return seconds > 0 ? events / seconds : 0; }
+};
+
+/**
+ * @brief Runs the simulation.
+ * @throws std::invalid_argument if the configuration is out of range.
+ */
+SimulationReport simulate(const SimulationConfig &config);
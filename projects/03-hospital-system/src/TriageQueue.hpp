@@ -0,0 +1,129 @@
+/**
+ * @file TriageQueue.hpp
+ * @brief Multi-level priority queue: FIFO within a level, most urgent level first.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @class TriageQueue
+ * @brief One FIFO per priority level plus a bitmask of the non-empty levels.
+ *
+ * Level 0 is the most urgent. push() appends to its level's FIFO and sets the level's bit;
+ * pop() finds the most urgent non-empty level with a single count-trailing-zeros on the
+ * bitmask, so both are O(1) whatever the number of queued items. Items of the same level
+ * leave in arrival order.
+ */
+template <typename T>
+class TriageQueue {
+   public:
+    static constexpr int MAX_LEVELS = 64;  ///< One bit per level in the mask
+    static constexpr size_t UNBOUNDED = 0;
+
+    /**
+     * @param levels Number of priority levels, 1 to MAX_LEVELS.
+     * @param capacity Maximum number of queued items, or UNBOUNDED.
+     */
+    explicit TriageQueue(int levels = 5, size_t capacity = UNBOUNDED)
+        : fifos(levels), maxItems(capacity) {
+        assert(levels >= 1 && levels <= MAX_LEVELS);
+    }
+
+    /**
+     * @brief Queues an item behind every item of the same or a more urgent level.
+     * @param item The item.
+     * @param level Its level, 0 (most urgent) to levels() - 1.
+     * @return False if the queue is full.
+     */
+    bool push(T item, int level) {
+        assert(level >= 0 && level < levels());
+        if (full()) return false;
+        fifos[level].push_back(std::move(item));
+        nonEmpty |= uint64_t{1} << level;
+        ++count;
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item of the most urgent non-empty level.
+     * @return The item, or nothing if the queue is empty.
+     */
+    std::optional<T> pop() {
+        if (nonEmpty == 0) return std::nullopt;
+        int level = lowestBit(nonEmpty);
+        std::deque<T>& fifo = fifos[level];
+        std::optional<T> item(std::move(fifo.front()));
+        fifo.pop_front();
+        if (fifo.empty()) nonEmpty &= nonEmpty - 1;
+        --count;
+        return item;
+    }
+
+    /**
+     * @brief The item pop() would return, or null if the queue is empty.
+     */
+    const T* peek() const { return nonEmpty ? &fifos[lowestBit(nonEmpty)].front() : nullptr; }
+
+    /**
+     * @brief The level pop() would take from, or -1 if the queue is empty.
+     */
+    int topLevel() const { return nonEmpty ? lowestBit(nonEmpty) : -1; }
+
+    /**
+     * @brief Calls `visit(item, level)` on every item, in pop order.
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (int level = 0; level < levels(); ++level) {
+            for (const T& item : fifos[level]) visit(item, level);
+        }
+    }
+
+    size_t size() const { return count; }
+    size_t size(int level) const { return fifos[level].size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return maxItems != UNBOUNDED && count >= maxItems; }
+    int levels() const { return static_cast<int>(fifos.size()); }
+    size_t capacity() const { return maxItems; }
+
+    void clear() {
+        for (auto& fifo : fifos) fifo.clear();
+        nonEmpty = 0;
+        count = 0;
+    }
+
+   private:
+    std::vector<std::deque<T>> fifos;
+    uint64_t nonEmpty{0};  ///< Bit l is set iff level l holds items
+    size_t count{0};
+    size_t maxItems;
+
+    static int lowestBit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(mask);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<int>(index);
+#else
+        int index = 0;
+        while (!(mask & 1)) {
+            mask >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+};
@@ -0,0 +1,191 @@
+#include "WriteAheadLog.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+/**
+ * @brief Forces everything written to `file` down to the disk.
+ */
+bool syncFile(std::FILE *file) {
+    if (std::fflush(file) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool parseRecord(const std::string &line, WriteAheadLog::Record &record) {
+    std::istringstream iss(line);
+    char op = 0;
+    if (!(iss >> record.lsn >> op >> record.spec) || record.spec < 0) return false;
+    if ((op != 'A' && op != 'C') || iss.get() != ' ') return false;
+    std::getline(iss, record.patient);
+    record.op = static_cast<WriteAheadLog::Op>(op);
+    return !record.patient.empty();
+}
+}  // namespace
+
+WriteAheadLog::WriteAheadLog(std::string path, Sync sync) : path(std::move(path)), sync(sync) {}
+
+WriteAheadLog::~WriteAheadLog() {
+    if (file) std::fclose(file);
+}
+
+std::vector<WriteAheadLog::Record> WriteAheadLog::recover(uint64_t checkpointLsn) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    std::string contents;
+    {
+        std::ifstream in(path, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::vector<Record> records;
+    broken = false;
+    size_t validEnd = 0;
+    uint64_t lastSeen = 0;
+    recordCount = 0;
+    while (validEnd < contents.size()) {
+        size_t end = contents.find('\n', validEnd);
+        Record record;
+        if (end == std::string::npos ||
+            !parseRecord(contents.substr(validEnd, end - validEnd), record) ||
+            record.lsn <= lastSeen) {
+            break;
+        }
+        lastSeen = record.lsn;
+        ++recordCount;
+        if (record.lsn > checkpointLsn) records.push_back(std::move(record));
+        validEnd = end + 1;
+    }
+    if (validEnd < contents.size()) {
+        std::cerr << "Warning: Cutting off " << contents.size() - validEnd
+                  << " bytes of an unfinished record at the end of " << path << std::endl;
+        std::error_code error;
+        std::filesystem::resize_file(path, validEnd, error);
+    }
+
+    nextLsn = std::max(lastSeen, checkpointLsn) + 1;
+    durableLsn = nextLsn - 1;
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) throw std::runtime_error("Cannot open the log " + path);
+    return records;
+}
+
+void WriteAheadLog::write(const std::string &data, bool durable) {
+    bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+                   (durable ? syncFile(file) : std::fflush(file) == 0);
+    if (!written) throw std::runtime_error("Cannot write to the log " + path);
+}
+
+uint64_t WriteAheadLog::append(Op op, int spec, const Patient &patient) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!file || broken) throw std::runtime_error("The log " + path + " is not open");
+    uint64_t lsn = nextLsn++;
+    std::string line = std::to_string(lsn) + ' ' + static_cast<char>(op) + ' ' +
+                       std::to_string(spec) + ' ' + patient.toString() + '\n';
+    ++recordCount;
+    if (sync != Sync::GroupCommit) {
+        try {
+            write(line, sync == Sync::EveryRecord);
+        } catch (const std::runtime_error &) {
+            broken = true;
+            throw;
+        }
+        if (sync == Sync::EveryRecord) ++syncs;
+        durableLsn = lsn;
+        return lsn;
+    }
+
+    pending += line;
+    while (durableLsn < lsn) {
+        if (broken) throw std::runtime_error("Cannot write to the log " + path);
+        if (flushing) {
+            flushed.wait(lock);
+            continue;
+        }
+        // Lead the next group: flush everything queued so far, without holding the lock so
+        // that more records can queue up for the group after this one
+        flushing = true;
+        std::string batch;
+        batch.swap(pending);
+        uint64_t batchEnd = nextLsn - 1;
+        lock.unlock();
+        bool written = true;
+        try {
+            write(batch, true);
+        } catch (const std::runtime_error &) {
+            written = false;
+        }
+        lock.lock();
+        flushing = false;
+        flushed.notify_all();
+        // A half-written batch would end the log on recovery: stop logging altogether
+        broken = !written;
+        if (broken) throw std::runtime_error("Cannot write to the log " + path);
+        durableLsn = batchEnd;
+        ++syncs;
+    }
+    return lsn;
+}
+
+void WriteAheadLog::reset() {
+    std::unique_lock<std::mutex> lock(mutex);
+    flushed.wait(lock, [this] { return !flushing; });
+    assert(pending.empty());
+    if (file) std::fclose(file);
+    // A truncation lost in a crash is harmless: the records are all in the checkpoint
+    file = std::fopen(path.c_str(), "wb");
+    recordCount = 0;
+    broken = false;
+    if (!file) throw std::runtime_error("Cannot open the log " + path);
+}
+
+uint64_t WriteAheadLog::lastLsn() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nextLsn - 1;
+}
+
+size_t WriteAheadLog::recordsSinceReset() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return recordCount;
+}
+
+uint64_t WriteAheadLog::syncCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncs;
+}
+
+bool durableReplace(const std::string &path, const std::string &contents) {
+    std::string temporary = path + ".tmp";
+    std::FILE *file = std::fopen(temporary.c_str(), "wb");
+    if (!file) return false;
+    bool written =
+        std::fwrite(contents.data(), 1, contents.size(), file) == contents.size() && syncFile(file);
+    written = std::fclose(file) == 0 && written;
+    std::error_code error;
+    if (written) std::filesystem::rename(temporary, path, error);
+    if (!written || error) {
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file WriteAheadLog.hpp
+ * @brief Append-only log of admitted and called patients, replayed after a crash.
+ *
+ * Every record is one text line:
+ *
+ *     <lsn> A <specialization> <patient>     patient admitted
+ *     <lsn> C <specialization> <patient>     patient called by a doctor
+ *
+ * where `lsn` (log sequence number) counts up from 1 and `patient` is Patient::toString().
+ * A checkpoint writes the whole hospital to `patients.txt`, tagged with the last lsn it
+ * contains, and then empties the log, so recovery is: load the checkpoint, then replay the
+ * records after its lsn. A line cut short by a crash ends the log and is cut off on recovery.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Patient.hpp"
+
+/**
+ * @class WriteAheadLog
+ * @brief Thread-safe writer and reader of the log.
+ */
+class WriteAheadLog {
+   public:
+    static constexpr const char *DEFAULT_FILE = "patients.wal";
+
+    /**
+     * @brief When an append is forced to disk.
+     */
+    enum class Sync {
+        None,         ///< Written to the OS only: survives a killed process, not a power cut
+        EveryRecord,  ///< One fsync per record, one record at a time
+        GroupCommit,  ///< One fsync per batch of the records appended while the last one ran
+    };
+
+    enum class Op : char { Admit = 'A', Call = 'C' };
+
+    struct Record {
+        uint64_t lsn{0};
+        Op op{Op::Admit};
+        int spec{0};
+        std::string patient;  ///< Patient::toString()
+    };
+
+    explicit WriteAheadLog(std::string path = DEFAULT_FILE, Sync sync = Sync::GroupCommit);
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog &) = delete;
+    WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+    /**
+     * @brief Reads the log, cuts off a torn last record and opens the log for appending.
+     * @param checkpointLsn The lsn of the last record already in the checkpoint.
+     * @return The records after `checkpointLsn`, in log order.
+     * @throws std::runtime_error if the log cannot be opened.
+     */
+    std::vector<Record> recover(uint64_t checkpointLsn);
+
+    /**
+     * @brief Appends a record. Returns once it is as durable as the sync mode promises.
+     *
+     * With GroupCommit, the first waiting thread writes and syncs every record queued so
+     * far while the others wait for it, so concurrent callers share one fsync.
+     * @return The record's lsn.
+     * @throws std::runtime_error if the record cannot be written.
+     */
+    uint64_t append(Op op, int spec, const Patient &patient);
+
+    /**
+     * @brief Empties the log after a checkpoint; lsns keep counting up.
+     */
+    void reset();
+
+    uint64_t lastLsn() const;
+    size_t recordsSinceReset() const;
+    uint64_t syncCount() const;  ///< Number of fsyncs so far
+    Sync syncMode() const { return sync; }
+
+   private:
+    std::string path;
+    Sync sync;
+    std::FILE *file{nullptr};
+
+    mutable std::mutex mutex;
+    std::condition_variable flushed;
+    std::string pending;  ///< GroupCommit: records waiting for the next flush
+    bool flushing{false};
+    bool broken{false};  ///< A write failed: every append throws until reset()
+    uint64_t nextLsn{1};
+    uint64_t durableLsn{0};
+    size_t recordCount{0};
+    uint64_t syncs{0};
+
+    /**
+     * @brief Writes `data` and forces it to disk if `durable`. Called with the lock held, or
+     * without it by the one flushing thread.
+     * @throws std::runtime_error if the write fails.
+     */
+    void write(const std::string &data, bool durable);
+};
+
+/**
+ * @brief Replaces a file atomically and durably: writes a temporary file, syncs it and
+ * renames it over `path`.
+ * @return False if any step fails; `path` is then left untouched.
+ */
+bool durableReplace(const std::string &path, const std::string &contents);
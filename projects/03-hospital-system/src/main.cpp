@@ -0,0 +1,87 @@
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "HospitalSystem.hpp"
+
+namespace {
+/**
+ * @brief Parses the value of `--sync=`.
+ */
+bool parseSync(const std::string &name, WriteAheadLog::Sync &sync) {
+    if (name == "none") {
+        sync = WriteAheadLog::Sync::None;
+    } else if (name == "record") {
+        sync = WriteAheadLog::Sync::EveryRecord;
+    } else if (name == "group") {
+        sync = WriteAheadLog::Sync::GroupCommit;
+    } else {
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+/**
+ * Usage: hospital_system [--concurrent] [--sync=none|record|group] [--aging=MINUTES]
+ *                        [--groups=GROUPS]
+ *                        [specializations] [triage levels] [capacity per specialization]
+ * (defaults: group commit, no aging, no groups, 20, 5 and 0, which means unlimited)
+ *
+ * GROUPS lists specializations whose doctors serve each other's patients when their own
+ * queue is empty, e.g. `--groups=1-3,7+9`.
+ */
+int main(int argc, char *argv[]) {
+    bool concurrent = false;
+    bool validOptions = true;
+    WriteAheadLog::Sync sync = WriteAheadLog::Sync::GroupCommit;
+    double agingMinutes = 0;
+    std::vector<std::vector<int>> groups;
+    int first = 1;
+    for (; first < argc && std::strncmp(argv[first], "--", 2) == 0; ++first) {
+        std::string option = argv[first];
+        if (option == "--concurrent") {
+            concurrent = true;
+        } else if (option.compare(0, 8, "--aging=") == 0) {
+            agingMinutes = std::atof(option.c_str() + 8);
+            validOptions = validOptions && agingMinutes > 0;
+        } else if (option.compare(0, 9, "--groups=") == 0) {
+            try {
+                groups = HospitalSystem::parseGroups(option.substr(9));
+            } catch (const std::invalid_argument &e) {
+                std::cerr << e.what() << "\n";
+                validOptions = false;
+            }
+        } else if (option.compare(0, 7, "--sync=") != 0 || !parseSync(option.substr(7), sync)) {
+            validOptions = false;
+        }
+    }
+    int specializations =
+        argc > first ? std::atoi(argv[first]) : HospitalSystem::DEFAULT_SPECIALIZATIONS;
+    int levels = argc > first + 1 ? std::atoi(argv[first + 1]) : HospitalSystem::DEFAULT_LEVELS;
+    long long capacity = argc > first + 2 ? std::atoll(argv[first + 2]) : 0;
+    if (!validOptions || (concurrent && agingMinutes > 0) || argc > first + 3 ||
+        specializations < 1 || specializations > HospitalSystem::MAX_SPECIALIZATIONS ||
+        levels < 1 || levels > TriageQueue<int>::MAX_LEVELS ||
+        capacity < 0) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--concurrent | --aging=MINUTES] [--sync=none|record|group]"
+                     " [--groups=1-3,7+9] [specializations 1-1000] [triage levels 1-64]"
+                     " [capacity, 0 = unlimited]\n";
+        return 1;
+    }
+    HospitalSystem system(specializations, levels, static_cast<size_t>(capacity), concurrent,
+                          sync, agingMinutes);
+    try {
+        system.setGroups(groups);
+        system.run();
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file DatabaseConverter.cpp
+ * @brief Converts the patient database between the text and the binary formats.
+ *
+ * Usage:
+ *     hospital_database_convert to-binary patients.txt patients.bin [levels]
+ *     hospital_database_convert to-text patients.bin patients.txt
+ *
+ * `levels` (default 5) only matters for files of the two-priority version. hospital_system
+ * prefers patients.bin over patients.txt when both exist. Converting a damaged binary file to
+ * text keeps every intact record, which also repairs it.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "BinaryDatabase.hpp"
+#include "HospitalSystem.hpp"
+
+int main(int argc, char *argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (argc < 4 || argc > 5 || (argc == 5 && mode != "to-binary")) {
+        std::cerr << "Usage: " << argv[0]
+                  << " (to-binary <text> <binary> [levels] | to-text <binary> <text>)\n";
+        return 1;
+    }
+    std::string error;
+    bool ok = false;
+    if (mode == "to-binary") {
+        int levels = argc == 5 ? std::atoi(argv[4]) : HospitalSystem::DEFAULT_LEVELS;
+        if (levels < 1 || levels > TriageQueue<int>::MAX_LEVELS) {
+            error = "levels must be 1-64";
+        } else {
+            ok = BinaryDatabase::convertTextToBinary(argv[2], argv[3], levels, error);
+        }
+    } else if (mode == "to-text") {
+        BinaryDatabase::ReadResult result;
+        ok = BinaryDatabase::convertBinaryToText(argv[2], argv[3], result, error);
+        if (ok && result.damaged > 0) {
+            std::cerr << "Skipped " << result.damaged << " damaged part(s), "
+                      << result.damagedBytes << " bytes; kept " << result.records
+                      << " patients\n";
+        }
+    } else {
+        error = "unknown mode '" + mode + "'";
+    }
+
+    if (!ok) {
+        std::cerr << "Conversion failed: " << error << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << argv[3] << "\n";
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file HospitalSimulator.cpp
+ * @brief Simulates a year (by default) of patients and doctors to size the staffing.
+ *
+ * Usage:
+ *     hospital_simulator [hours] [arrivals per hour] [doctors] [service minutes]
+ *                        [urgent ratio] [capacity] [specializations] [levels] [seed]
+ *                        [aging minutes] [groups]
+ *
+ * Arrivals and doctors take a comma-separated list, one value per specialization, the last
+ * one repeating: `hospital_simulator 8760 6,4,2 2,1` gives specialization 1 six arrivals an
+ * hour and two doctors and every other one two arrivals and one doctor. Defaults: 8760 hours,
+ * 4 arrivals, 1 doctor, 12 minutes, 10% urgent, unlimited capacity (0), 20 specializations,
+ * 5 levels, seed 1, no aging, no groups. Groups take the hospital_system `--groups` syntax,
+ * e.g. `1-3,7+9`.
+ */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "HospitalSystem.hpp"
+#include "Simulation.hpp"
+
+namespace {
+/**
+ * @brief Parses "a,b,c" into numbers.
+ * @throws std::invalid_argument on anything that is not a number.
+ */
+template <typename T>
+std::vector<T> parseList(const std::string &text) {
+    std::vector<T> values;
+    std::istringstream iss(text);
+    std::string part;
+    while (getline(iss, part, ',')) {
+        std::istringstream number(part);
+        T value;
+        if (!(number >> value) || !number.eof()) {
+            throw std::invalid_argument("Not a number list: " + text);
+        }
+        values.push_back(value);
+    }
+    return values;
+}
+
+void printWaitHeader(const std::string &first) {
+    std::cout << std::setw(6) << first << std::setw(10) << "mean" << std::setw(10) << "p50"
+              << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "max";
+}
+
+void printWait(const WaitSummary &wait) {
+    std::cout << std::setw(10) << wait.mean << std::setw(10) << wait.p50 << std::setw(10)
+              << wait.p90 << std::setw(10) << wait.p99 << std::setw(10) << wait.max;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc > 12) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [hours] [arrivals per hour] [doctors] [service minutes] [urgent ratio]"
+                     " [capacity] [specializations] [levels] [seed] [aging minutes] [groups]\n";
+        return 1;
+    }
+    SimulationConfig config;
+    SimulationReport report;
+    try {
+        if (argc > 1) config.hours = std::stod(argv[1]);
+        if (argc > 2) config.arrivalsPerHour = parseList<double>(argv[2]);
+        if (argc > 3) config.doctors = parseList<int>(argv[3]);
+        if (argc > 4) config.serviceMinutes = std::stod(argv[4]);
+        if (argc > 5) config.urgentRatio = std::stod(argv[5]);
+        if (argc > 6) config.capacity = std::stoull(argv[6]);
+        if (argc > 7) config.specializations = std::stoi(argv[7]);
+        if (argc > 8) config.levels = std::stoi(argv[8]);
+        if (argc > 9) config.seed = std::stoull(argv[9]);
+        if (argc > 10) config.agingMinutes = std::stod(argv[10]);
+        if (argc > 11) config.groups = HospitalSystem::parseGroups(argv[11]);
+        report = simulate(config);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    uint64_t arrivals = 0, rejected = 0, served = 0, steals = 0;
+    for (const SpecializationReport &spec : report.specializations) {
+        arrivals += spec.arrivals;
+        rejected += spec.rejected;
+        served += spec.served;
+        steals += spec.stealsIn;
+    }
+    std::cout << std::fixed << std::setprecision(2) << config.hours << " hours, "
+              << config.specializations << " specializations, " << config.levels
+              << " levels, capacity "
+              << (config.capacity ? std::to_string(config.capacity) : "unlimited") << "\n"
+              << report.events << " events in " << report.seconds << " s ("
+              << static_cast<long long>(report.eventsPerSecond()) << " events/s)\n"
+              << arrivals << " arrivals, " << served << " served, " << rejected << " rejected, "
+              << steals << " served by another specialization\n\n";
+
+    std::cout << "waits in minutes per specialization\n";
+    printWaitHeader("spec");
+    std::cout << std::setw(8) << "rate" << std::setw(6) << "drs" << std::setw(8) << "util%"
+              << std::setw(9) << "avg q" << std::setw(7) << "max q" << std::setw(10)
+              << "rejected" << std::setw(8) << "stole" << std::setw(8) << "stolen" << "\n";
+    for (size_t s = 0; s < report.specializations.size(); ++s) {
+        const SpecializationReport &spec = report.specializations[s];
+        std::cout << std::setw(6) << s + 1;
+        printWait(spec.wait);
+        std::cout << std::setw(8) << spec.arrivalsPerHour << std::setw(6) << spec.doctors
+                  << std::setw(8) << 100 * spec.utilization << std::setw(9) << spec.meanQueue
+                  << std::setw(7) << spec.maxQueue << std::setw(10) << spec.rejected
+                  << std::setw(8) << spec.stealsIn << std::setw(8) << spec.stealsOut << "\n";
+    }
+
+    std::cout << "\nwaits in minutes per triage level\n";
+    printWaitHeader("level");
+    std::cout << std::setw(10) << "patients" << "\n";
+    for (size_t level = 0; level < report.levels.size(); ++level) {
+        std::cout << std::setw(6) << level + 1;
+        printWait(report.levels[level]);
+        std::cout << std::setw(10) << report.levels[level].patients << "\n";
+    }
+    return 0;
+}